@@ -13,7 +13,20 @@ public:
         SUB,
         DIV,
         MUL,
-        MOD
+        MOD,
+        ALLOC,
+        FREE,
+        READ,
+        WRITE,
+        FORK,
+        ATTACH,
+        DETACH,
+        SEND,
+        RECV,
+        LOCK,
+        UNLOCK,
+        SEM_WAIT,
+        SEM_SIGNAL
     };
 
     ICommand(int pid, CommandType commandType);
@@ -0,0 +1,96 @@
+#include <algorithm>
+
+#include "InstructionGenerator.h"
+
+InstructionGenerator::OptionalOpcode InstructionGenerator::optionalOpcodes[MAX_OPTIONAL_OPCODES];
+int InstructionGenerator::numOptionalOpcodes = 0;
+int InstructionGenerator::blockLines = 0;
+
+Instruction InstructionGenerator::generate(uint64_t seed, int line){
+    return generate(seed, seed, line);
+}
+
+Instruction InstructionGenerator::generate(uint64_t programSeed, uint64_t operandSeed, int line){
+    uint64_t bits = mix(programSeed + static_cast<uint64_t>(line) * 0x9E3779B97F4A7C15ULL);
+
+    static const ICommand::CommandType opcodes[] = {
+        ICommand::PRINT, ICommand::ADD, ICommand::SUB, ICommand::MUL, ICommand::DIV, ICommand::MOD
+    };
+
+    Instruction instruction;
+    instruction.type = opcodes[(bits & 0xFFFF) % (sizeof(opcodes) / sizeof(opcodes[0]))];
+
+    // Optional opcodes take their share of lines off the top of a separate roll
+    if (numOptionalOpcodes > 0){
+        int roll = static_cast<int>((bits >> 16) & 0xFFFF) % 100;
+        for (int i = 0; i < numOptionalOpcodes; ++i){
+            if (roll < optionalOpcodes[i].percent){
+                instruction.type = optionalOpcodes[i].type;
+                break;
+            }
+            roll -= optionalOpcodes[i].percent;
+        }
+    }
+
+    // Bits 48 and up are the only ones neither the opcode, the roll nor the value use
+    if (blockLines > 0)
+        instruction.var = static_cast<uint8_t>(mix(programSeed ^ (static_cast<uint64_t>(line / blockLines) * 0xD1B54A32D192ED03ULL)) % NUM_VARIABLES);
+    else
+        instruction.var = static_cast<uint8_t>((bits >> 48) % NUM_VARIABLES);
+    instruction.value = (operandSeed == programSeed) ? toValue(bits) : generateValue(operandSeed, line);
+
+    return instruction;
+}
+
+uint16_t InstructionGenerator::generateValue(uint64_t operandSeed, int line){
+    return toValue(mix(operandSeed + static_cast<uint64_t>(line) * 0x9E3779B97F4A7C15ULL));
+}
+
+uint16_t InstructionGenerator::toValue(uint64_t bits){
+    uint16_t value = static_cast<uint16_t>(bits >> 32);
+
+    // Keep DIV/MOD operands non-zero
+    return value == 0 ? 1 : value;
+}
+
+uint64_t InstructionGenerator::templateSeed(int index){
+    return mix(0x5EED0000ULL + static_cast<uint64_t>(index));
+}
+
+void InstructionGenerator::setOpcodePercent(ICommand::CommandType type, int percent){
+    percent = std::max(0, std::min(percent, 100));
+
+    for (int i = 0; i < numOptionalOpcodes; ++i){
+        if (optionalOpcodes[i].type == type){
+            optionalOpcodes[i].percent = percent;
+            return;
+        }
+    }
+
+    if (numOptionalOpcodes < MAX_OPTIONAL_OPCODES && percent > 0)
+        optionalOpcodes[numOptionalOpcodes++] = { type, percent };
+}
+
+int InstructionGenerator::getOpcodePercent(ICommand::CommandType type){
+    for (int i = 0; i < numOptionalOpcodes; ++i){
+        if (optionalOpcodes[i].type == type)
+            return optionalOpcodes[i].percent;
+    }
+
+    return 0;
+}
+
+void InstructionGenerator::setBlockLines(int lines){
+    blockLines = std::max(0, lines);
+}
+
+int InstructionGenerator::getBlockLines(){
+    return blockLines;
+}
+
+// splitmix64 finalizer
+uint64_t InstructionGenerator::mix(uint64_t x){
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
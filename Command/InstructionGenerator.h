@@ -0,0 +1,60 @@
+#pragma once
+#ifndef INSTRUCTION_GENERATOR_H
+#define INSTRUCTION_GENERATOR_H
+
+#include <cstdint>
+
+#include "ICommand.h"
+
+// Decoded form of a single generated instruction. Small enough to be produced on the fly
+// for every line, so a process never has to keep its program in memory.
+struct Instruction{
+    ICommand::CommandType type;
+    uint8_t var;
+    uint16_t value;
+};
+
+class InstructionGenerator{
+public:
+    static const int NUM_VARIABLES = 8;
+
+    // Instruction at the given line of the program identified by seed. The same (seed, line)
+    // pair always yields the same instruction, so lines can be regenerated after swap-in.
+    static Instruction generate(uint64_t seed, int line);
+
+    // Opcodes and variables come from programSeed, operand values from operandSeed. Processes
+    // sharing a programSeed run the same opcode sequence with different data.
+    static Instruction generate(uint64_t programSeed, uint64_t operandSeed, int line);
+
+    // Operand value alone, for callers that already decoded the opcode from a shared programSeed
+    static uint16_t generateValue(uint64_t operandSeed, int line);
+
+    static uint64_t templateSeed(int index);
+
+    // Optional opcodes such as SLEEP are left out of programs unless given a share (in percent)
+    // of the generated lines
+    static void setOpcodePercent(ICommand::CommandType type, int percent);
+    static int getOpcodePercent(ICommand::CommandType type);
+
+    // With block lines set, each run of that many lines works on one variable, giving instruction
+    // fusion runs to merge. 0, the default, picks a variable per line.
+    static void setBlockLines(int lines);
+    static int getBlockLines();
+
+private:
+    static const int MAX_OPTIONAL_OPCODES = 16;
+
+    struct OptionalOpcode{
+        ICommand::CommandType type;
+        int percent;
+    };
+
+    static OptionalOpcode optionalOpcodes[MAX_OPTIONAL_OPCODES];
+    static int numOptionalOpcodes;
+    static int blockLines;
+
+    static uint64_t mix(uint64_t x);
+    static uint16_t toValue(uint64_t bits);
+};
+
+#endif
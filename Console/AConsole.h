@@ -13,6 +13,8 @@ public:
     virtual void onEnabled() = 0;
     virtual void display() = 0;
     virtual void process() = 0;
+    // Prints the console once without waiting for input, for headless runs
+    virtual void snapshot() = 0;
 
 protected:
     std::string name;
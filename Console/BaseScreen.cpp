@@ -4,9 +4,15 @@
 #include "ConsoleManager.h"
 #include "../Processor/CommandProcessor.h"
 #include "../UI/UI_Manager.h"
+#include "../Processor/ObjectPool.h"
+#include "../Memory/Memory.h"
 
 BaseScreen::BaseScreen(std::shared_ptr<Process> process, const std::string &processName) : AConsole(processName), attachedProcess(process) {}
 
+std::shared_ptr<BaseScreen> BaseScreen::create(std::shared_ptr<Process> process, const std::string &processName){
+    return std::allocate_shared<BaseScreen>(PoolAllocator<BaseScreen>(), process, processName);
+}
+
 void BaseScreen::onEnabled(){
     refreshed = true;
     printProcessInfo();
@@ -20,6 +26,10 @@ void BaseScreen::display(){
     }
 }
 
+void BaseScreen::snapshot(){
+    printProcessInfo();
+}
+
 void BaseScreen::process(){
     UI_Manager& ui = UI_Manager::getInstance();
     ConsoleManager* consoleManager = ConsoleManager::getInstance();
@@ -69,7 +79,41 @@ void BaseScreen::printProcessInfo() const{
     std::cout << "Process: " << this->attachedProcess->getName() << std::endl;
     std::cout << "ID: " << this->attachedProcess->getPID() << std::endl;
     std::cout << std::endl;
+    std::cout << "Current instruction line: " << this->attachedProcess->getCurrInstructions() << std::endl;
     std::cout << "Lines of code: " << this->attachedProcess->getCommandCounter() << std::endl;
+
+    if (this->attachedProcess->getHeapPages() > 0){
+        std::cout << "Heap: " << this->attachedProcess->getHeapBytes() << " bytes in " << this->attachedProcess->getHeapAllocations()
+                  << " blocks, " << this->attachedProcess->getHeapPages() << " pages" << std::endl;
+    }
+
+    auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(Memory::getInstance().getAllocator());
+    size_t tables, tableBytes, hugePages;
+    if (pagingAllocator && pagingAllocator->getPageTableInfo(this->attachedProcess.get(), tables, tableBytes, hugePages))
+        std::cout << "Page Table: " << tables << " tables, " << tableBytes << " bytes, " << hugePages << " huge pages" << std::endl;
+
+    uint64_t cacheAccesses, l1Misses, l2Misses;
+    this->attachedProcess->getCacheStatistics(cacheAccesses, l1Misses, l2Misses);
+    if (cacheAccesses > 0){
+        std::cout << "Cache: " << cacheAccesses << " accesses, L1 miss rate " << 100.0 * l1Misses / cacheAccesses << "%, L2 miss rate "
+                  << (l1Misses > 0 ? 100.0 * l2Misses / l1Misses : 0.0) << "%" << std::endl;
+    }
+
+    if (Process::getPriorityLevels() > 1){
+        std::cout << "Priority: " << this->attachedProcess->getPriority();
+        if (this->attachedProcess->getEffectivePriority() != this->attachedProcess->getPriority())
+            std::cout << " (inherited " << this->attachedProcess->getEffectivePriority() << ")";
+        std::cout << std::endl;
+    }
+
+    std::vector<std::string> output = this->attachedProcess->getOutput();
+    if (!output.empty()){
+        std::cout << std::endl;
+        std::cout << "Logs:" << std::endl;
+        for (const std::string &line : output)
+            std::cout << line << '\n';
+        std::cout.flush();
+    }
 }
 
 std::shared_ptr<Process> BaseScreen::getProcess() const{
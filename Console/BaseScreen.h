@@ -8,9 +8,11 @@
 class BaseScreen : public AConsole{
 public:
     BaseScreen(std::shared_ptr<Process> process, const std::string &processName);
+    static std::shared_ptr<BaseScreen> create(std::shared_ptr<Process> process, const std::string &processName);
     void onEnabled() override;
     void display() override;
     void process() override;
+    void snapshot() override;
 
     std::shared_ptr<Process> getProcess() const;
 
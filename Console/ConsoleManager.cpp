@@ -30,7 +30,9 @@ void ConsoleManager::destroy(){
 ConsoleManager::ConsoleManager(){
     running = true;
 
+#ifdef _WIN32
     consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+#endif
 
     const std::shared_ptr<MainConsole> mainConsole = std::make_shared<MainConsole>();
     const std::shared_ptr<MarqueeConsole> marqueeConsole = std::make_shared<MarqueeConsole>();
@@ -60,7 +62,22 @@ void ConsoleManager::process() const{
 
 void ConsoleManager::switchConsole(const std::string &consoleName) {
     auto it = consoleTable.find(consoleName);
-    if (it != consoleTable.end()){
+
+    // Generated processes get their screen on first use instead of at creation
+    if (it == consoleTable.end()){
+        ProcessTable& table = ProcessTable::getInstance();
+        uint32_t index = table.findByName(consoleName);
+        if (index != ProcessTable::NONE){
+            registerScreen(BaseScreen::create(table.getSharedProcess(index), consoleName));
+            it = consoleTable.find(consoleName);
+        }
+    }
+
+    // A headless run has nobody to type into another console, so it only gets a printout of it
+    if (it != consoleTable.end() && ui.isHeadless() && currConsole){
+        it->second->snapshot();
+    }
+    else if (it != consoleTable.end()){
         ui.clear();
         prevConsole = currConsole;
         currConsole = it->second;
@@ -127,7 +144,7 @@ void ConsoleManager::listScreens() const {
 
     std::cout << "Finished Processes:" << std::endl;
     for (const auto& process : finishedProcesses){
-        std::cout << "Process: " << process->getName() << " (" << process->getTimestamp() << ") | Core: " << "Finished" << " | ";
+        std::cout << "Process: " << process->getName() << " (" << process->getTimestamp() << ") | Core: " << (process->isOomKilled() ? "Killed (OOM)" : "Finished") << " | ";
         std::cout << process->getCurrInstructions() << " / " << process->getMaxInstructions() << std::endl;
     }
 
@@ -173,10 +190,19 @@ void ConsoleManager::listScreens(std::ofstream& logfile) const{
 
     logfile << "Finished Processes:" << std::endl;
     for (const auto& process : finishedProcesses) {
-        logfile << "Process: " << process->getName() << " (" << process->getTimestamp() << ") | Core: " << "Finished" << " | ";
+        logfile << "Process: " << process->getName() << " (" << process->getTimestamp() << ") | Core: " << (process->isOomKilled() ? "Killed (OOM)" : "Finished") << " | ";
         logfile << process->getCurrInstructions() << " / " << process->getMaxInstructions() << std::endl;
     }
 
+    std::vector<Scheduler::OomKill> oomKills = scheduler.getOomKills();
+    if (!oomKills.empty()){
+        logfile << std::endl << std::endl;
+
+        logfile << "OOM Kills: " << oomKills.size() << std::endl;
+        for (const auto& kill : oomKills)
+            logfile << "Process: " << kill.name << " (" << kill.timestamp << ") | Memory: " << kill.memoryKB << " KB | Badness: " << kill.badness << std::endl;
+    }
+
     logfile << "---------------------------" << std::endl;
 }
 
@@ -196,6 +222,8 @@ bool ConsoleManager::isRunning() const{
     return running;
 }
 
+#ifdef _WIN32
 HANDLE ConsoleManager::getConsoleHandle() const{
     return consoleHandle;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -5,7 +5,6 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
-#include <Windows.h>
 
 #include "../UI/UI_Manager.h"
 #include "AConsole.h"
@@ -39,7 +38,9 @@ public:
     void exit();
     bool isRunning() const;
 
+#ifdef _WIN32
     HANDLE getConsoleHandle() const;
+#endif
 
 private:
     ConsoleManager();
@@ -51,7 +52,9 @@ private:
     std::shared_ptr<AConsole> currConsole;
     std::shared_ptr<AConsole> prevConsole;
 
+#ifdef _WIN32
     HANDLE consoleHandle;
+#endif
     bool running = true;
 };
 
@@ -7,11 +7,18 @@
 #include "../../UI/UI_Manager.h"
 #include "../../Processor/Scheduler.h"
 #include "../../Processor/CommandProcessor.h"
+#include "../../Processor/Benchmark.h"
+#include "../../Processor/ChannelTable.h"
+#include "../../Processor/SyncTable.h"
+#include "../../Memory/PageMerger.h"
 
 MainConsole::MainConsole() : BaseScreen(nullptr, MAIN_CONSOLE) {}
 
 void MainConsole::onEnabled(){
     UI_Manager& ui = UI_Manager::getInstance();
+    if (ui.isHeadless())
+        return;
+
     ui.clear();
     ui.printMainHeader();
     ui.printMainWelcome();
@@ -21,6 +28,10 @@ void MainConsole::display(){
     std::cout << "Main Console Display" << std::endl;
 }
 
+void MainConsole::snapshot(){
+    display();
+}
+
 void MainConsole::process(){
     std::string command;
     std::cout << std::endl << "Enter a command:>";
@@ -32,6 +43,53 @@ void MainConsole::process(){
         processCommand(command);
 }
 
+// Runs commands from a script file or piped stdin, one per line, as if typed at the prompt. Blank
+// lines and lines starting with '#' are skipped, and 'wait <seconds>' pauses the script while the
+// scheduler keeps running. The end of the input exits like 'exit'.
+void MainConsole::runScript(std::istream &input){
+    ConsoleManager* consoleManager = ConsoleManager::getInstance();
+    CommandProcessor& processor = CommandProcessor::getInstance();
+    std::string command;
+
+    while (consoleManager->isRunning() && std::getline(input, command)){
+        // Scripts saved on Windows keep their carriage returns
+        if (!command.empty() && command.back() == '\r')
+            command.pop_back();
+
+        size_t start = command.find_first_not_of(" \t");
+        if (start == std::string::npos || command[start] == '#')
+            continue;
+
+        command = command.substr(start);
+        std::cout << "> " << command << std::endl;
+
+        std::vector<std::string> tokens = processor.tokenize(command, ' ');
+        if (tokens[0] == "wait"){
+            double seconds = 1.0;
+            try{
+                if (tokens.size() > 1)
+                    seconds = std::stod(tokens[1]);
+            }
+            catch (const std::exception&){
+                std::cout << "Error: 'wait' Expects A Number Of Seconds." << std::endl;
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(secondsToMilliseconds(seconds)));
+        }
+        else if (!initialized)
+            initialization(command);
+        else
+            processCommand(command);
+    }
+
+    if (consoleManager->isRunning()){
+        if (initialized)
+            processCommand("exit");
+        else
+            initialization("exit");
+    }
+}
+
 void MainConsole::processCommand(const std::string &command){
     UI_Manager& ui = UI_Manager::getInstance();
     ConsoleManager* consoleManager = ConsoleManager::getInstance();
@@ -69,33 +127,93 @@ void MainConsole::processCommand(const std::string &command){
     {
         vmStat(memory->getAllocator()->getName());
     }
+    else if (command_0 == "iostat")
+    {
+        ResourceEmulator::getInstance().printStatistics();
+    }
+    else if (command_0 == "ipcstat")
+    {
+        ChannelTable::getInstance().printStatistics();
+    }
+    else if (command_0 == "lockstat")
+    {
+        SyncTable::getInstance().printStatistics();
+    }
+    else if (command_0 == "loadstat")
+    {
+        scheduler->printLoadHistory();
+    }
+    else if (command_0 == "cpustat")
+    {
+        scheduler->printCpuStatistics();
+    }
     else if (command_0 == "view-config")
     {
         std::cout << std::endl;
         scheduler->getInfo();
         std::cout << std::endl << std::endl;
         memory->getInfo();
+        std::cout << std::endl << std::endl;
+        ResourceEmulator::getInstance().getInfo();
     }
     else if (command_0 == "screen")
     {
-        if(tokens.size() == 3)
+        if(tokens.size() == 5 && tokens[1] == "-s" && tokens[3] == "--from")
         {
-            if(tokens[1] == "-s")
-            {
-                // Generate PID
+            ProcessTable& table = ProcessTable::getInstance();
+            uint32_t parentIndex = table.findByName(tokens[4]);
+            std::shared_ptr<Process> parent = parentIndex != ProcessTable::NONE ? table.getSharedProcess(parentIndex) : nullptr;
+
+            if (!parent)
+                std::cout << "Error: Process '" << tokens[4] << "' Cannot Be Found." << std::endl;
+            else if (parent->getProcessState() == Process::FINISHED)
+                std::cout << "Error: Process '" << tokens[4] << "' Has Already Finished." << std::endl;
+            else{
                 int pid = ui.generatePID();
+                std::shared_ptr<Process> newProcess = scheduler->forkIdleProcess(parent.get(), pid, tokens[2]);
+                if (!newProcess){
+                    std::cout << "Error: Process '" << tokens[4] << "' Is Running On A Core. Try Again." << std::endl;
+                    return;
+                }
 
-                // Set requirement flags
-                Process::RequirementFlags reqFlags = {true, 1, true, 512};
+                std::shared_ptr<BaseScreen> newScreen = BaseScreen::create(newProcess, tokens[2]);
 
-                //Get current timestamp
-                std::string timestamp = ui.generateTimestamp();
+                if (consoleManager->registerScreen(newScreen)){
+                    std::cout << "Screen Name: '" << tokens[2] << "' successfully forked from '" << tokens[4] << "'." << std::endl;
+                    consoleManager->switchConsole(tokens[2]);
+                    scheduler->addForkedProcess(newProcess, parent.get());
+
+                    ui.clear();
+                    onEnabled();
+                }
+                else
+                    std::cout << "Error: Screen Name '" << tokens[2] << "' Already Exists. Use A Different Name." << std::endl;
+            }
+        }
+        else if((tokens.size() == 3 || (tokens.size() == 5 && tokens[3] == "-g")) && tokens[1] == "-s")
+        {
+            // Screens are interactive unless another group is named. A group defined only as a memory
+            // group or only as a CPU group leaves the process interactive for the other.
+            int memoryGroup = Memory::INTERACTIVE_GROUP;
+            int cpuGroup = CpuBandwidth::INTERACTIVE_GROUP;
+            if (tokens.size() == 5){
+                memoryGroup = memory->findGroup(tokens[4]);
+                cpuGroup = scheduler->getCpuBandwidth().findGroup(tokens[4]);
+            }
+
+            if (memoryGroup < 0 && cpuGroup < 0)
+                std::cout << "Error: Group '" << tokens[4] << "' Does Not Exist." << std::endl;
+            else{
+                // Generate PID
+                int pid = ui.generatePID();
 
                 // Create Process
-                std::shared_ptr<Process> newProcess = std::make_shared<Process>(pid, tokens[2], reqFlags, timestamp, scheduler->getMinInstructions(), scheduler->getMaxInstructions(), scheduler->getMinMem(), scheduler->getMaxMem(), scheduler->getMinPage(), scheduler->getMaxPage());
+                std::shared_ptr<Process> newProcess = scheduler->createProcess(pid, tokens[2]);
+                newProcess->setMemoryGroup(memoryGroup >= 0 ? memoryGroup : Memory::INTERACTIVE_GROUP);
+                newProcess->setCpuGroup(cpuGroup >= 0 ? cpuGroup : CpuBandwidth::INTERACTIVE_GROUP);
 
                 // Create Screen with Process
-                std::shared_ptr<BaseScreen> newScreen = std::make_shared<BaseScreen>(newProcess, tokens[2]);
+                std::shared_ptr<BaseScreen> newScreen = BaseScreen::create(newProcess, tokens[2]);
 
                 if (consoleManager->registerScreen(newScreen)){
                     std::cout << "Screen Name: '" << tokens[2] << "' successfully created." << std::endl;
@@ -108,7 +226,10 @@ void MainConsole::processCommand(const std::string &command){
                 else
                     std::cout << "Error: Screen Name '" << tokens[2] << "' Already Exists. Use A Different Name." << std::endl;
             }
-            else if(tokens[1] == "-r")
+        }
+        else if(tokens.size() == 3)
+        {
+            if(tokens[1] == "-r")
             {
                 consoleManager->switchConsole(tokens[2]);
             }
@@ -169,9 +290,16 @@ void MainConsole::processCommand(const std::string &command){
             std::cerr << "Error generating report: " << e.what() << std::endl;
         }
     }
+    else if (command_0 == "benchmark")
+    {
+        if (tokens.size() == 2)
+            Benchmark::run(tokens[1]);
+        else
+            Benchmark::printList();
+    }
     else if (command_0 == "exit")
     {
-
+        schedulerStop();
         scheduler->shutdown();
         consoleManager->exit();
         std::cout << "Program Terminated Successfully." << std::endl;
@@ -185,24 +313,24 @@ void MainConsole::processCommand(const std::string &command){
 }
 
 void MainConsole::schedulerStart(){
-    UI_Manager& ui = UI_Manager::getInstance();
-    ConsoleManager* consoleManager = ConsoleManager::getInstance();
+    auto startTime = std::chrono::steady_clock::now();
+    long long generated = 0;
 
     while(runScheduler){
-        int pid = ui.generatePID();
-        Process::RequirementFlags reqFlags = { true, 1, true, 512 };
-        std::string timestamp = ui.generateTimestamp();
-        std::string name = "p_" + std::to_string(pid);
-
-        std::shared_ptr<Process> newProcess = std::make_shared<Process>(pid, name, reqFlags, timestamp, scheduler->getMinInstructions(), scheduler->getMaxInstructions(), scheduler->getMinMem(), scheduler->getMaxMem(), scheduler->getMinPage(), scheduler->getMaxPage());
+        double frequency = scheduler->getBatchProcessFrequency();
 
-        std::shared_ptr<BaseScreen> newScreen = std::make_shared<BaseScreen>(newProcess, name);
-        consoleManager->registerScreen(newScreen);
-        scheduler->addProcess(newProcess);
+        // Create every process that has come due since the start in one batch, so intervals
+        // shorter than the sleep granularity still reach the configured rate
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        long long due = (frequency > 0) ? static_cast<long long>(elapsed.count() / frequency) + 1 : generated + 1;
 
-        double frequency = scheduler->getBatchProcessFrequency();
+        if (due > generated){
+            int count = static_cast<int>(std::min<long long>(due - generated, MAX_BATCH_PROCESSES));
+            scheduler->addProcesses(scheduler->generateProcesses(count));
+            generated += count;
+        }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(frequency * 1000)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::max(1, secondsToMilliseconds(frequency))));
     }
     std::cout << "Scheduler thread stopping" << std::endl;
 }
@@ -249,6 +377,16 @@ void MainConsole::initialization(const std::string &command){
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
+        // Initialize I/O Devices
+        try {
+            ResourceEmulator::getInstance().readConfigFile("config.txt");
+            std::cout << "I/O device configuration loaded successfully." << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error initializing I/O devices: " << e.what() << std::endl;
+            return;
+        }
+
         // Equip Memory to Scheduler
         scheduler->setMemory(*memory);
 
@@ -275,7 +413,7 @@ void MainConsole::printDetails(){
     std::cout << "----------------------------------------" << std::endl;
     std::cout << "Screen Name: Main Console" << std::endl;
     std::cout << "Screen ID: 1000" << std::endl;
-    std::cout << "Available Number of Commands: 13" << std::endl;
+    std::cout << "Available Number of Commands: " << ui.getMainCommandCount() << std::endl;
     std::cout << "Current Time: " << ui.generateTimestamp() << std::endl;
     std::cout << "----------------------------------------" << std::endl;
 }
@@ -300,11 +438,62 @@ void MainConsole::vmStat(const std::string &allocator){
     std::cout << "      Active CPU Ticks:       " << activeTicks << std::endl;
     std::cout << "      Idle CPU Ticks:         " << idleTicks << std::endl;
 
+    ProcessTable& table = ProcessTable::getInstance();
+    std::cout << "      Process Table Slots:    " << table.size() << std::endl;
+    std::cout << "      Waiting Processes:      " << table.countInState(Process::WAITING) << std::endl;
+    std::cout << "      Running Processes:      " << table.countInState(Process::RUNNING) << std::endl;
+    std::cout << "      Finished Processes:     " << table.countInState(Process::FINISHED) << std::endl;
+    std::cout << "      Sleeping Processes:     " << scheduler->getSleepQueueDepth() << std::endl;
+    std::cout << "      Blocked (I/O, IPC):     " << table.countInState(Process::BLOCKED) << std::endl;
+    std::cout << "      Suspended Processes:    " << scheduler->getSuspendedCount() << std::endl;
+    std::cout << "      Awaiting Admission:     " << scheduler->getPendingAdmissions() << std::endl;
+    std::cout << "      Committed Memory:       " << scheduler->getCommittedMemory() << " KB of "
+              << (memory->getCommitLimit() > 0 ? std::to_string(memory->getCommitLimit()) + " KB" : std::string("unlimited")) << std::endl;
+    std::cout << "      Swap Used:              " << scheduler->getSwapUsed() << " KB of "
+              << (memory->getSwapSize() > 0 ? std::to_string(memory->getSwapSize()) + " KB" : std::string("unbounded")) << std::endl;
+    std::cout << "      OOM Kills:              " << scheduler->getOomKills().size() << std::endl;
+    std::cout << "      Heap Pages:             " << ProcessHeap::getTotalPages() << std::endl;
+    std::cout << "      Heap In Use:            " << ProcessHeap::getTotalBytesInUse() << " bytes" << std::endl;
+    std::cout << "      Heap Alloc Failures:    " << ProcessHeap::getTotalFailures() << std::endl;
+
+    uint64_t accesses = memory->getMemoryAccesses();
+    uint64_t faults = memory->getPageFaults();
+    std::cout << "      Memory Accesses:        " << accesses << std::endl;
+    std::cout << "      Page Faults:            " << faults << std::endl;
+    std::cout << "      Fault Rate:             " << (accesses > 0 ? 100.0 * faults / accesses : 0.0) << "% ("
+              << scheduler->getFaultRate() << " faults/s)" << std::endl;
+    std::cout << "      Page Write-Backs:       " << memory->getPageWriteBacks() << std::endl;
+
+    for (int core = 0; memory->getTLB(core); ++core){
+        const TLB* tlb = memory->getTLB(core);
+        uint64_t lookups = tlb->getHits() + tlb->getMisses();
+        std::string label = "TLB Core " + std::to_string(core) + ":";
+        std::cout << "      " << std::left << std::setw(24) << label << std::right
+                  << (lookups > 0 ? 100.0 * tlb->getHits() / lookups : 0.0) << "% hits of " << lookups << ", "
+                  << tlb->getFlushes() << " flushes (" << tlb->getFlushedEntries() << " entries)" << std::endl;
+    }
+    if (memory->isHugePageTracking())
+        std::cout << "      TLB Misses Saved:       " << memory->getHugePageMissesSaved() << " (by huge pages)" << std::endl;
+    for (int core = 0; memory->getL1Cache(core); ++core){
+        const Cache* cache = memory->getL1Cache(core);
+        uint64_t lookups = cache->getHits() + cache->getMisses();
+        std::string label = "L1 Core " + std::to_string(core) + ":";
+        std::cout << "      " << std::left << std::setw(24) << label << std::right
+                  << (lookups > 0 ? 100.0 * cache->getMisses() / lookups : 0.0) << "% misses of " << lookups << std::endl;
+    }
+    if (const Cache* cache = memory->getL2Cache()){
+        uint64_t lookups = cache->getHits() + cache->getMisses();
+        std::cout << "      L2 Shared:              " << (lookups > 0 ? 100.0 * cache->getMisses() / lookups : 0.0)
+                  << "% misses of " << lookups << std::endl;
+    }
+    std::cout << "      Avg Wakeup Lateness:    " << scheduler->getAverageWakeupLateness() << " ms" << std::endl;
+    std::cout << "      Max Wakeup Lateness:    " << scheduler->getMaxWakeupLateness() << " ms" << std::endl;
+
     if (allocator == "PagingMemoryAllocator"){
         auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(memory->getAllocator());
         if (pagingAllocator){
             size_t activeMemory = pagingAllocator->getActiveMem();
-            size_t inactiveMemory = usedMemory - activeMemory;
+            size_t inactiveMemory = usedMemory > activeMemory ? usedMemory - activeMemory : 0;
             int numPagedIn = scheduler->numPagedIn;
             int numPagedOut = scheduler->numPagedOut;
 
@@ -312,6 +501,33 @@ void MainConsole::vmStat(const std::string &allocator){
             std::cout << "      Inactive Memory:        " << inactiveMemory << " KB" << std::endl;
             std::cout << "      Pages In:               " << numPagedIn << std::endl;
             std::cout << "      Pages Out:              " << numPagedOut << std::endl;
+
+            size_t tableBytes, flatBytes, hugePages;
+            pagingAllocator->getPageTableTotals(tableBytes, flatBytes, hugePages);
+            std::cout << "      Page Table Memory:      " << tableBytes / 1024.0 << " KB (flat arrays: " << flatBytes / 1024.0 << " KB)" << std::endl;
+            std::cout << "      Huge Pages:             " << hugePages << std::endl;
+
+            size_t sharedFrames, privateFrames, savedFrames;
+            pagingAllocator->getFrameSharing(sharedFrames, privateFrames, savedFrames);
+            std::cout << "      Forks:                  " << scheduler->numForks << std::endl;
+            std::cout << "      Shared Frames:          " << sharedFrames << " (saving " << savedFrames << " KB)" << std::endl;
+            std::cout << "      Private Frames:         " << privateFrames << std::endl;
+            std::cout << "      COW Copies:             " << memory->getCopyOnWriteCopies() << std::endl;
+
+            size_t segmentsInUse, attachments, segmentFrames;
+            pagingAllocator->getSegmentInfo(segmentsInUse, attachments, segmentFrames);
+            std::cout << "      Shared Segments:        " << segmentsInUse << " of " << memory->getSegmentCount() << " ("
+                      << attachments << " attachments, " << segmentFrames << " KB)" << std::endl;
+
+            PageMerger& merger = PageMerger::getInstance();
+            if (merger.isEnabled()){
+                std::cout << "      Pages Scanned:          " << merger.getPagesScanned() << " (" << merger.getPasses() << " passes)" << std::endl;
+                std::cout << "      Pages Merged:           " << merger.getPagesMerged() << std::endl;
+                size_t mergedFrames, mergedSaved;
+                pagingAllocator->getMergedSharing(mergedFrames, mergedSaved);
+                std::cout << "      Merged Frames:          " << mergedFrames << std::endl;
+                std::cout << "      Merging Saved:          " << mergedSaved << " KB" << std::endl;
+            }
         }
     }
 
@@ -319,7 +535,7 @@ void MainConsole::vmStat(const std::string &allocator){
         auto flatAllocator = dynamic_cast<FlatMemoryAllocator*>(memory->getAllocator());
         if (flatAllocator){
             size_t activeMemory = flatAllocator->getActiveMem();
-            size_t inactiveMemory = usedMemory - activeMemory;
+            size_t inactiveMemory = usedMemory > activeMemory ? usedMemory - activeMemory : 0;
 
             std::cout << "      Active Memory:          " << activeMemory << " KB" << std::endl;
             std::cout << "      Inactive Memory:        " << inactiveMemory << " KB" << std::endl;
@@ -329,6 +545,10 @@ void MainConsole::vmStat(const std::string &allocator){
     std::cout << std::endl;
     std::cout << "+----------------------------------------+" << std::endl;
 }
+int MainConsole::secondsToMilliseconds(double seconds){
+    return static_cast<int>(seconds * 1000);
+}
+
 MainConsole::~MainConsole(){
     scheduler = nullptr;
 }
\ No newline at end of file
@@ -16,7 +16,9 @@ public:
     void onEnabled() override;
     void display() override;
     void process() override;
+    void snapshot() override;
     void processCommand(const std::string &command);
+    void runScript(std::istream &input);
     
     void initialization(const std::string &command);
     void printDetails();
@@ -29,6 +31,8 @@ public:
     std::thread schedulerStartThread;
 
 private:
+    static const int MAX_BATCH_PROCESSES = 10000;
+
     std::atomic<bool> runScheduler { false };
     bool initialized = false;
     Scheduler* scheduler;
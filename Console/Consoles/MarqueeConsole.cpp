@@ -2,6 +2,11 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#ifndef _WIN32
+#include <termios.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 #include "MarqueeConsole.h"
 #include "../ConsoleManager.h"
@@ -35,6 +40,10 @@ void MarqueeConsole::display(){
     std::cout << "Marquee Console Display" << std::endl;
 }
 
+void MarqueeConsole::snapshot(){
+    std::cout << "The marquee console needs a terminal and is not available in headless mode." << std::endl;
+}
+
 void MarqueeConsole::process(){
     while(active){
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -99,12 +108,47 @@ void MarqueeConsole::marquee(const std::string &text, std::atomic<bool>& running
     }
 }
 
-void MarqueeConsole::pollInput(std::atomic<bool>& running){
+// Takes the next key press without waiting, with Enter as '\n' and Backspace as '\b'
+bool MarqueeConsole::readKey(char &key){
+#ifdef _WIN32
     HANDLE hInput = GetStdHandle(STD_INPUT_HANDLE);
     INPUT_RECORD inputRecord;
     DWORD events;
     DWORD bytesRead;
 
+    if (PeekConsoleInput(hInput, &inputRecord, 1, &events) && events > 0){
+        if (ReadConsoleInput(hInput, &inputRecord, 1, &bytesRead) && inputRecord.EventType == KEY_EVENT && inputRecord.Event.KeyEvent.bKeyDown){
+            WORD virtualKey = inputRecord.Event.KeyEvent.wVirtualKeyCode;
+            key = virtualKey == VK_RETURN ? '\n' : virtualKey == VK_BACK ? '\b' : inputRecord.Event.KeyEvent.uChar.AsciiChar;
+            return true;
+        }
+    }
+    return false;
+#else
+    pollfd input = { STDIN_FILENO, POLLIN, 0 };
+    if (poll(&input, 1, 0) <= 0 || read(STDIN_FILENO, &key, 1) != 1)
+        return false;
+
+    if (key == '\r')
+        key = '\n';
+    else if (key == 127)
+        key = '\b';
+    return true;
+#endif
+}
+
+void MarqueeConsole::pollInput(std::atomic<bool>& running){
+#ifndef _WIN32
+    // Keys have to arrive one at a time, without echo, while the marquee redraws
+    termios original;
+    bool terminal = tcgetattr(STDIN_FILENO, &original) == 0;
+    if (terminal){
+        termios raw = original;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+#endif
+
     while (running.load()){
         std::unique_lock<std::mutex> lock(mtx);
         cv.wait(lock);
@@ -115,32 +159,34 @@ void MarqueeConsole::pollInput(std::atomic<bool>& running){
         for (auto key : stackInput)
             std::cout << key;
 
-        if (PeekConsoleInput(hInput, &inputRecord, 1, &events) && events > 0){
-            if (ReadConsoleInput(hInput, &inputRecord, 1, &bytesRead) && inputRecord.EventType == KEY_EVENT && inputRecord.Event.KeyEvent.bKeyDown){
-                WORD virtualKey = inputRecord.Event.KeyEvent.wVirtualKeyCode;
-                char key = inputRecord.Event.KeyEvent.uChar.AsciiChar;
-                if (virtualKey == VK_RETURN){
-                    std::string stringInput(stackInput.begin(), stackInput.end());
-                    std::string prevCommand = "Enter Marquee Command>" + stringInput;
-
-                    previousCommands.push_back(prevCommand);
-                    if (previousCommands.size() > 4)
-                        previousCommands.pop_front();
-
-                    processMarqueeCommand(stringInput);
-
-                    stackInput.clear();
-                }
-                else if (virtualKey == VK_BACK){
-                    if (!stackInput.empty())
-                        stackInput.pop_back();
-                }
-                else
-                    stackInput.push_back(key);
+        char key;
+        if (readKey(key)){
+            if (key == '\n'){
+                std::string stringInput(stackInput.begin(), stackInput.end());
+                std::string prevCommand = "Enter Marquee Command>" + stringInput;
+
+                previousCommands.push_back(prevCommand);
+                if (previousCommands.size() > 4)
+                    previousCommands.pop_front();
+
+                processMarqueeCommand(stringInput);
+
+                stackInput.clear();
+            }
+            else if (key == '\b'){
+                if (!stackInput.empty())
+                    stackInput.pop_back();
             }
+            else
+                stackInput.push_back(key);
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(60));
     }
+
+#ifndef _WIN32
+    if (terminal)
+        tcsetattr(STDIN_FILENO, TCSANOW, &original);
+#endif
 }
 
 void MarqueeConsole::displayPreviousCommands(const std::deque<std::string>& previousCommands){
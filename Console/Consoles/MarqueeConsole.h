@@ -18,6 +18,7 @@ public:
     void onEnabled() override;
     void display() override;
     void process() override;
+    void snapshot() override;
     void processMarqueeCommand(const std::string &command);
     void marquee(const std::string &text, std::atomic<bool>& running);
     void pollInput(std::atomic<bool>& running);
@@ -28,6 +29,7 @@ public:
 
 private:
     void reset();
+    bool readKey(char &key);
 
     std::mutex mtx;
     std::condition_variable cv;
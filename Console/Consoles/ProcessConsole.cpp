@@ -11,32 +11,48 @@
 #include "../../Processor/CommandProcessor.h"
 #include "../../Memory/Memory.h"
 
-ProcessConsole::ProcessConsole() : BaseScreen(nullptr, PROCESS_CONSOLE){}
+namespace {
+    const int VALUE_COLOR = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY;
+    const int TITLE_COLOR = FOREGROUND_RED | FOREGROUND_BLUE | FOREGROUND_INTENSITY;
+}
+
+ProcessConsole::ProcessConsole() : BaseScreen(nullptr, PROCESS_CONSOLE), running(false), nextRow(12), autoRefresh(false){}
 
 void ProcessConsole::onEnabled(){
     running = true;
 
+    // The console manager has just cleared the screen, so the first frame is drawn whole
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        frame.invalidate();
+        status.clear();
+    }
+
     this->display();
 }
 
 void ProcessConsole::display(){
-    UI_Manager& ui = UI_Manager::getInstance();
-    ui.clear();
-    displayHeader();
-    displaySubHeader();
-    displayProcessHeader();
-    displayProcessBody();
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        render();
+    }
+    startRefresh();
 
     this->process();
 }
 
+void ProcessConsole::snapshot(){
+    std::lock_guard<std::mutex> lock(frameMutex);
+    drawFrame();
+    std::cout << frame.toText();
+}
+
 void ProcessConsole::process(){
     while(running){
         std::string command;
-        std::cout << std::endl;
-        std::cout << "Type 'refresh' to see updates every now and then." << std::endl;
-        std::cout << "root:\\>";
-        std::getline(std::cin, command);
+        drawPrompt();
+        if (!std::getline(std::cin, command))
+            command = "exit";
         processCommand(command);
     }
 }
@@ -54,53 +70,126 @@ void ProcessConsole::processCommand(const std::string &command){
 
     if (command_0 == "exit")
     {
+        stopRefresh();
         running = false;
         consoleManager->switchConsole(MAIN_CONSOLE);
     }
     else if (command_0 == "refresh")
     {
-        ui.clear();
-        onEnabled();
+        showStatus("");
+    }
+    else if (command_0 == "auto" && tokens.size() == 2)
+    {
+        try{
+            ui.setRefreshInterval(std::stoi(tokens[1]));
+        }
+        catch (const std::exception&){
+            showStatus("Invalid refresh interval: " + tokens[1]);
+            return;
+        }
+
+        stopRefresh();
+        showStatus("");
+        startRefresh();
     }
     else
     {
-        std::cout << "Unrecognized command:>" << command << std::endl;
+        showStatus("Unrecognized command:>" + command);
+    }
+}
+
+void ProcessConsole::startRefresh(){
+    int interval = UI_Manager::getInstance().getRefreshInterval();
+    if (interval <= 0 || refresher.joinable())
+        return;
+
+    autoRefresh = true;
+    refresher = std::thread(&ProcessConsole::refreshLoop, this, interval);
+}
+
+void ProcessConsole::stopRefresh(){
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        autoRefresh = false;
     }
+    refreshCondition.notify_all();
+
+    if (refresher.joinable())
+        refresher.join();
+}
+
+void ProcessConsole::refreshLoop(int interval){
+    std::unique_lock<std::mutex> lock(frameMutex);
+
+    while (autoRefresh){
+        refreshCondition.wait_for(lock, std::chrono::milliseconds(interval), [this]{ return !autoRefresh; });
+        if (autoRefresh)
+            render();
+    }
+}
+
+void ProcessConsole::render(){
+    drawFrame();
+    frame.present();
+}
+
+void ProcessConsole::drawFrame(){
+    // Idle cores keep an empty row, so the frame only changes height if the core count does
+    int processRows = std::max(Scheduler::getInstance().getNumCores(), static_cast<int>(Scheduler::getInstance().getRunningProcesses().size()));
+    int groupRows = static_cast<int>(Memory::getInstance().getGroupUsage().size());
+
+    frame.resize(WIDTH, 12 + processRows + 1 + 4 + groupRows + 1 + 3);
+    frame.clear();
+
+    displayHeader();
+    displaySubHeader();
+    displayProcessHeader();
+    displayProcessBody();
+    displayGroupBody();
+    displayHint();
+}
+
+// Moves below the frame and clears the last command typed there
+void ProcessConsole::drawPrompt(){
+    std::lock_guard<std::mutex> lock(frameMutex);
+    std::cout << "\x1b[" << frame.getHeight() + 1 << ";1H\x1b[K" << "root:\\>" << std::flush;
+}
+
+int ProcessConsole::put(int x, int y, const std::string &text, int color){
+    frame.put(x, y, text, color);
+    return x + static_cast<int>(text.size());
 }
 
-void ProcessConsole::divider(int type){
+void ProcessConsole::border(int y){
+    frame.put(0, y, "|");
+    frame.put(WIDTH - 1, y, "|");
+}
+
+void ProcessConsole::divider(int y, int type){
     if(type == 1)
-        std::cout << "+----------------------------------------------------------------------------------------------------+" << std::endl;
+        frame.put(0, y, "+----------------------------------------------------------------------------------------------------+");
     else if (type == 2)
-        std::cout << "+-----------------------------------------------+--------------------------+-------------------------+" << std::endl;
+        frame.put(0, y, "+-----------------------------------------------+--------------------------+-------------------------+");
     else if (type == 3)
-        std::cout << "+====================================================================================================+" << std::endl;
+        frame.put(0, y, "+====================================================================================================+");
     else if (type == 4)
-        std::cout << "+===============================================+==========================+=========================+" << std::endl;
+        frame.put(0, y, "+===============================================+==========================+=========================+");
 }
 
 void ProcessConsole::displayHeader(){
-    UI_Manager& ui = UI_Manager::getInstance();
-
-    divider(1);
-    std::cout << "| ";
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_INTENSITY, "PROCESS-SMI V01.23");
-    ui.setCursorPosition(40, 1);
-    ui.setTextColor(FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY, "Driver Version: 551.86");
-    ui.setCursorPosition(82, 1);
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, "CUDA Version: 12.4");
-    ui.setCursorPosition(100, 1);
-    std::cout << " |" << std::endl;
-    divider(1);
+    divider(0, 1);
+    border(1);
+    put(2, 1, "PROCESS-SMI V01.23", FOREGROUND_RED | FOREGROUND_INTENSITY);
+    put(40, 1, "Driver Version: 551.86", FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY);
+    put(82, 1, "CUDA Version: 12.4", FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY);
+    divider(2, 1);
 }
 
 void ProcessConsole::displaySubHeader(){
-    UI_Manager& ui = UI_Manager::getInstance();
     Scheduler& scheduler = Scheduler::getInstance();
     Memory& memory = Memory::getInstance();
 
     std::vector<std::shared_ptr<Process>> runningProcesses = scheduler.getRunningProcesses();
-    std::vector<std::shared_ptr<Process>> finishedProcesses = scheduler.getFinishedProcesses();
 
     int totalCores = scheduler.getNumCores();
     int usedCores = 0;
@@ -115,105 +204,131 @@ void ProcessConsole::displaySubHeader(){
     size_t totalMemory = memory.getMaxSize();
     size_t usedMemory = memory.getCurrentOverallMemoryUsage();
 
-
     int memoryUtilization = (totalMemory > 0) ? (usedMemory * 100 / totalMemory) : 0;
-    
-    std::cout << "| ";
-    ui.setCursorPosition(51, 3);
-    std::cout << " | ";
-    ui.setCursorPosition(100, 3);
-    std::cout << " |" << std::endl;
-
-    std::cout << "| ";
-    std::cout << "Cpu Utilization: ";
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(cpuUtilization));
-    std::cout << " %";
-    ui.setCursorPosition(51, 4);
-    std::cout << " | ";
-    std::cout << "Memory Utilization: ";
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(memoryUtilization));
-    std::cout << " %";
-    ui.setCursorPosition(100, 4);
-    std::cout << " |" << std::endl;
-
-    std::cout << "| ";
-    std::cout << "Core Usage: ";
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(usedCores));
-    std::cout << " / ";
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(totalCores));
-    ui.setCursorPosition(51, 5);
-    std::cout << " | ";
-    std::cout << "Memory Usage: ";
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(usedMemory) + " KB");
-    std::cout << " / ";
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(totalMemory) + " KB");
-    ui.setCursorPosition(100, 5);
-    std::cout << " |" << std::endl;
-
-    std::cout << "| ";
-    ui.setCursorPosition(51, 6);
-    std::cout << " | ";
-    ui.setCursorPosition(100, 6);
-    std::cout << " |" << std::endl;
-
-    divider(3);
+
+    for (int y = 3; y <= 6; ++y){
+        border(y);
+        frame.put(52, y, "|");
+    }
+
+    int x = put(2, 4, "Cpu Utilization: ");
+    x = put(x, 4, std::to_string(cpuUtilization), VALUE_COLOR);
+    put(x, 4, " %");
+    x = put(54, 4, "Memory Utilization: ");
+    x = put(x, 4, std::to_string(memoryUtilization), VALUE_COLOR);
+    put(x, 4, " %");
+
+    x = put(2, 5, "Core Usage: ");
+    x = put(x, 5, std::to_string(usedCores), VALUE_COLOR);
+    x = put(x, 5, " / ");
+    put(x, 5, std::to_string(totalCores), VALUE_COLOR);
+    x = put(54, 5, "Memory Usage: ");
+    x = put(x, 5, std::to_string(usedMemory) + " KB", VALUE_COLOR);
+    x = put(x, 5, " / ");
+    put(x, 5, std::to_string(totalMemory) + " KB", VALUE_COLOR);
+
+    divider(7, 3);
 }
 
 void ProcessConsole::displayProcessHeader(){
-    UI_Manager& ui = UI_Manager::getInstance();
-    
-    std::cout << "| ";
-    ui.setCursorPosition(33, 8);
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_BLUE | FOREGROUND_INTENSITY, "RUNNING PROCESSES");
-    ui.setTextColor(FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY, " AND ");
-    ui.setTextColor(FOREGROUND_RED | FOREGROUND_BLUE | FOREGROUND_INTENSITY, "MEMORY USAGE");
-    ui.setCursorPosition(100, 8);
-    std::cout << " |" << std::endl;
-    divider(3); 
-
-    std::cout << "| ";
-    std::cout << "Process Name";
-    ui.setCursorPosition(23, 10);
-    std::cout << "Timestamp";
-    ui.setCursorPosition(46, 10);
-    std::cout << "Core";
-    ui.setCursorPosition(60, 10);
-    std::cout << "Process Progress";
-    ui.setCursorPosition(85, 10);
-    std::cout << "Memory Usage";
-    ui.setCursorPosition(100, 10);
-    std::cout << " |" << std::endl;
-    divider(1);
+    border(8);
+    int x = put(33, 8, "RUNNING PROCESSES", TITLE_COLOR);
+    x = put(x, 8, " AND ", FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY);
+    put(x, 8, "MEMORY USAGE", TITLE_COLOR);
+    divider(9, 3);
+
+    border(10);
+    put(2, 10, "Process Name");
+    put(23, 10, "Timestamp");
+    put(46, 10, "Core");
+    put(60, 10, "Process Progress");
+    put(85, 10, "Memory Usage");
+    divider(11, 1);
 }
 
 void ProcessConsole::displayProcessBody(){
-    UI_Manager& ui = UI_Manager::getInstance();
     Scheduler& scheduler = Scheduler::getInstance();
     std::vector<std::shared_ptr<Process>> runningProcesses = scheduler.getRunningProcesses();
 
     int y = 12;
+    int rows = std::max(scheduler.getNumCores(), static_cast<int>(runningProcesses.size()));
 
     for (const auto& process : runningProcesses){
-        std::cout << "| ";
-        std::cout << process->getName();
-        ui.setCursorPosition(14, y);
-        std::cout << process->getTimestamp();
-        ui.setCursorPosition(47, y);
-        ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(process->getCpuCoreID()));
-        ui.setCursorPosition(63, y);
-        ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(process->getCurrInstructions()));
-        std::cout << " / ";
-        ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(process->getMaxInstructions()));
-        ui.setCursorPosition(87, y);
-        ui.setTextColor(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY, std::to_string(process->getMemRequired()) + " KB");
-        ui.setCursorPosition(100, y);
-        std::cout << " |" << std::endl;
+        border(y);
+        put(2, y, process->getName());
+        put(14, y, process->getTimestamp());
+        put(47, y, std::to_string(process->getCpuCoreID()), VALUE_COLOR);
+        int x = put(63, y, std::to_string(process->getCurrInstructions()), VALUE_COLOR);
+        x = put(x, y, " / ");
+        put(x, y, std::to_string(process->getMaxInstructions()), VALUE_COLOR);
+        put(87, y, std::to_string(process->getMemRequired()) + " KB", VALUE_COLOR);
 
         y += 1;
     }
 
-    divider(1);
+    for (; y < 12 + rows; ++y)
+        border(y);
+
+    divider(y, 1);
+    nextRow = y + 1;
+}
+
+// Memory use of each group against its limit and reservation, with the allocations it was refused
+// and the processes swapped out of it
+void ProcessConsole::displayGroupBody(){
+    std::vector<Memory::GroupUsage> groups = Memory::getInstance().getGroupUsage();
+    int y = nextRow;
+
+    border(y);
+    put(42, y, "MEMORY GROUPS", TITLE_COLOR);
+    divider(y + 1, 3);
+    y += 2;
+
+    border(y);
+    put(2, y, "Group");
+    put(18, y, "Usage");
+    put(32, y, "Peak");
+    put(46, y, "Limit");
+    put(60, y, "Reserve");
+    put(74, y, "Refused");
+    put(87, y, "Reclaimed");
+    divider(y + 1, 1);
+    y += 2;
+
+    for (const auto& group : groups){
+        border(y);
+        put(2, y, group.name);
+        put(18, y, std::to_string(group.usedKB) + " KB", VALUE_COLOR);
+        put(32, y, std::to_string(group.peakKB) + " KB", VALUE_COLOR);
+        put(46, y, group.limitKB > 0 ? std::to_string(group.limitKB) + " KB" : "none", VALUE_COLOR);
+        put(60, y, std::to_string(group.reserveKB) + " KB", VALUE_COLOR);
+        put(74, y, std::to_string(group.refusals), VALUE_COLOR);
+        put(87, y, std::to_string(group.reclaims), VALUE_COLOR);
+
+        y += 1;
+    }
 
+    divider(y, 1);
+    nextRow = y + 1;
 }
 
-ProcessConsole::~ProcessConsole() {}
\ No newline at end of file
+void ProcessConsole::displayHint(){
+    int interval = UI_Manager::getInstance().getRefreshInterval();
+
+    if (interval > 0)
+        put(0, nextRow + 1, "Refreshing every " + std::to_string(interval) + " ms. Type 'auto <ms>' to change the rate, 'auto 0' to stop.");
+    else
+        put(0, nextRow + 1, "Type 'refresh' to see updates, or 'auto <ms>' to refresh them on a timer.");
+
+    put(0, nextRow + 2, status, FOREGROUND_RED | FOREGROUND_INTENSITY);
+}
+
+void ProcessConsole::showStatus(const std::string &message){
+    std::lock_guard<std::mutex> lock(frameMutex);
+    status = message;
+    render();
+}
+
+ProcessConsole::~ProcessConsole() {
+    stopRefresh();
+}
@@ -2,8 +2,16 @@
 #ifndef PROCESS_CONSOLE_H
 #define PROCESS_CONSOLE_H
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 #include "../BaseScreen.h"
+#include "../../UI/ScreenBuffer.h"
 
+// Each frame is drawn into a ScreenBuffer and only the cells that changed since the last one are
+// written, so the view can redraw itself on a timer ('auto <ms>', or smi-refresh-ms in the config)
+// without clearing the screen. The prompt sits below the frame and is left alone by redraws.
 class ProcessConsole : public BaseScreen{
 public:
     ProcessConsole();
@@ -11,17 +19,44 @@ public:
     void onEnabled() override;
     void display() override;
     void process() override;
+    void snapshot() override;
     void processCommand(const std::string &command);
 
 private:
+    static constexpr int WIDTH = 102;
+
     bool running;
+    // Row below the last one drawn, for the sections under the process list
+    int nextRow;
+
+    ScreenBuffer frame;
+    // Held while a frame is drawn or written, by the input loop and the refresh thread alike
+    std::mutex frameMutex;
+    std::thread refresher;
+    std::condition_variable refreshCondition;
+    bool autoRefresh;
+    // Reply to the last command, drawn under the hint so redraws keep it on screen
+    std::string status;
+
+    void startRefresh();
+    void stopRefresh();
+    void refreshLoop(int interval);
+    // Draws and writes a frame; the caller holds frameMutex
+    void render();
+    void drawFrame();
+    void drawPrompt();
 
-    void divider(int type);
+    int put(int x, int y, const std::string &text, int color = 0);
+    void border(int y);
+    void divider(int y, int type);
     void displayHeader();
     void displaySubHeader();
     void displayProcessHeader();
     void displayProcessBody();
+    void displayGroupBody();
+    void displayHint();
+    void showStatus(const std::string &message);
 };
 
 
-#endif
\ No newline at end of file
+#endif
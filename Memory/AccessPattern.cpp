@@ -0,0 +1,101 @@
+#include <cmath>
+#include <algorithm>
+
+#include "AccessPattern.h"
+
+AccessPattern::Kind AccessPattern::kind = AccessPattern::SEQUENTIAL;
+uint64_t AccessPattern::stride = 4096;
+double AccessPattern::skew = 0.99;
+
+uint64_t AccessPattern::next(FastRandom &random, uint64_t spaceBytes){
+    uint64_t words = std::max<uint64_t>(spaceBytes / WORD_BYTES, 1);
+
+    switch (kind){
+        case SEQUENTIAL:
+            cursor = (cursor + WORD_BYTES) % (words * WORD_BYTES);
+            return cursor;
+        case STRIDED:
+            cursor = (cursor + stride) % (words * WORD_BYTES);
+            return cursor - cursor % WORD_BYTES;
+        case UNIFORM:
+            return (random.next() % words) * WORD_BYTES;
+        case ZIPFIAN:
+        default:{
+            uint64_t blocks = std::max<uint64_t>(spaceBytes / BLOCK_BYTES, 1);
+            uint64_t blockWords = std::min(words, BLOCK_BYTES / WORD_BYTES);
+            return nextZipfBlock(random, blocks) * BLOCK_BYTES + (random.next() % blockWords) * WORD_BYTES;
+        }
+    }
+}
+
+// Gray et al.'s generator: O(1) per draw once zeta(n) is known, which only changes with the size
+uint64_t AccessPattern::nextZipfBlock(FastRandom &random, uint64_t blocks){
+    if (blocks != zipfBlocks){
+        zipfBlocks = blocks;
+        zetaN = zeta(blocks, skew);
+        alpha = 1.0 / (1.0 - skew);
+        eta = (1.0 - std::pow(2.0 / blocks, 1.0 - skew)) / (1.0 - zeta(2, skew) / zetaN);
+    }
+
+    double u = static_cast<double>(random.next() >> 11) * 0x1.0p-53;
+    double uz = u * zetaN;
+
+    if (uz < 1.0)
+        return 0;
+    if (uz < 1.0 + std::pow(0.5, skew))
+        return std::min<uint64_t>(1, blocks - 1);
+
+    uint64_t block = static_cast<uint64_t>(blocks * std::pow(eta * u - eta + 1.0, alpha));
+    return std::min(block, blocks - 1);
+}
+
+double AccessPattern::zeta(uint64_t n, double theta){
+    double sum = 0;
+    for (uint64_t i = 1; i <= n; ++i)
+        sum += 1.0 / std::pow(static_cast<double>(i), theta);
+
+    return sum;
+}
+
+bool AccessPattern::setKind(const std::string &name){
+    if (name == "sequential")
+        kind = SEQUENTIAL;
+    else if (name == "strided")
+        kind = STRIDED;
+    else if (name == "uniform")
+        kind = UNIFORM;
+    else if (name == "zipfian")
+        kind = ZIPFIAN;
+    else
+        return false;
+
+    return true;
+}
+
+std::string AccessPattern::getKindName(){
+    switch (kind){
+        case SEQUENTIAL: return "sequential";
+        case STRIDED: return "strided";
+        case UNIFORM: return "uniform";
+        case ZIPFIAN: return "zipfian";
+    }
+
+    return "unknown";
+}
+
+void AccessPattern::setStride(uint64_t bytes){
+    stride = std::max(bytes, WORD_BYTES);
+}
+
+uint64_t AccessPattern::getStride(){
+    return stride;
+}
+
+// The generator needs 0 < skew < 1; values near 1 give the classic hot set
+void AccessPattern::setSkew(double value){
+    skew = std::min(std::max(value, 0.01), 0.999);
+}
+
+double AccessPattern::getSkew(){
+    return skew;
+}
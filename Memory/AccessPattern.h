@@ -0,0 +1,55 @@
+#pragma once
+#ifndef ACCESS_PATTERN_H
+#define ACCESS_PATTERN_H
+
+#include <cstdint>
+#include <string>
+
+#include "../Processor/FastRandom.h"
+
+// Address stream of one process's READ/WRITE instructions. Sequential walks the address space word
+// by word, strided jumps a fixed number of bytes, uniform picks any word and zipfian sends most
+// accesses to a hot set of 1 KB blocks at the bottom of the address space.
+class AccessPattern{
+public:
+    enum Kind
+    {
+        SEQUENTIAL,
+        STRIDED,
+        UNIFORM,
+        ZIPFIAN
+    };
+
+    static constexpr uint64_t WORD_BYTES = 2;
+
+    // Byte offset of the next word in an address space of the given size
+    uint64_t next(FastRandom &random, uint64_t spaceBytes);
+
+    // Shared by every process, from the memory config keys
+    static bool setKind(const std::string &name);
+    static std::string getKindName();
+    static void setStride(uint64_t bytes);
+    static uint64_t getStride();
+    static void setSkew(double value);
+    static double getSkew();
+
+private:
+    static constexpr uint64_t BLOCK_BYTES = 1024;
+
+    uint64_t nextZipfBlock(FastRandom &random, uint64_t blocks);
+    static double zeta(uint64_t n, double theta);
+
+    uint64_t cursor = 0;
+
+    // Zipf constants for the current number of blocks, recomputed when the address space grows
+    uint64_t zipfBlocks = 0;
+    double zetaN = 0;
+    double alpha = 0;
+    double eta = 0;
+
+    static Kind kind;
+    static uint64_t stride;
+    static double skew;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include <algorithm>
+
+#include "Cache.h"
+
+Cache::Cache(size_t sizeBytes, int ways, size_t lineBytes, Replacement replacement)
+    : lineBytes(std::max<size_t>(lineBytes, 1)), replacement(replacement), clock(0), random(FastRandom::streamSeed(0xCAC4E)), hits(0), misses(0){
+    size_t numLines = std::max<size_t>(sizeBytes / this->lineBytes, 1);
+    this->ways = std::max(1, std::min(ways, static_cast<int>(numLines)));
+    numSets = std::max<size_t>(numLines / this->ways, 1);
+    lines.resize(numSets * this->ways);
+}
+
+bool Cache::access(uint64_t physicalAddress){
+    uint64_t block = physicalAddress / lineBytes;
+    uint64_t tag = block / numSets;
+    Line* first = &lines[(block % numSets) * ways];
+    Line* victim = nullptr;
+    ++clock;
+
+    for (Line* line = first; line < first + ways; ++line){
+        if (line->valid && line->tag == tag){
+            if (replacement == LRU)
+                line->stamp = clock;
+            ++hits;
+            return true;
+        }
+
+        if (!line->valid && !victim)
+            victim = line;
+    }
+
+    // With the set full, LRU and FIFO both evict the oldest stamp
+    if (!victim){
+        if (replacement == RANDOM)
+            victim = first + random.nextInt(0, ways - 1);
+        else
+            victim = std::min_element(first, first + ways, [](const Line &a, const Line &b){ return a.stamp < b.stamp; });
+    }
+
+    victim->valid = true;
+    victim->tag = tag;
+    victim->stamp = clock;
+    ++misses;
+    return false;
+}
+
+size_t Cache::getSizeBytes() const{
+    return lines.size() * lineBytes;
+}
+
+int Cache::getWays() const{
+    return ways;
+}
+
+uint64_t Cache::getHits() const{
+    return hits;
+}
+
+uint64_t Cache::getMisses() const{
+    return misses;
+}
+
+bool Cache::parseReplacement(const std::string &name, Replacement &replacement){
+    if (name == "lru")
+        replacement = LRU;
+    else if (name == "fifo")
+        replacement = FIFO;
+    else if (name == "random")
+        replacement = RANDOM;
+    else
+        return false;
+
+    return true;
+}
+
+std::string Cache::getReplacementName(Replacement replacement){
+    switch (replacement){
+        case LRU: return "lru";
+        case FIFO: return "fifo";
+        case RANDOM: return "random";
+    }
+
+    return "unknown";
+}
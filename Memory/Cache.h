@@ -0,0 +1,57 @@
+#pragma once
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <atomic>
+
+#include "../Processor/FastRandom.h"
+
+// Set-associative cache over physical addresses. Only tags are kept, since the emulator just
+// needs to know whether an access hits. Used for the private L1 of each core and the shared L2.
+class Cache{
+public:
+    enum Replacement
+    {
+        LRU,
+        FIFO,
+        RANDOM
+    };
+
+    Cache(size_t sizeBytes, int ways, size_t lineBytes, Replacement replacement);
+
+    // True on a hit; a miss fills the line, evicting one from its set if needed
+    bool access(uint64_t physicalAddress);
+
+    size_t getSizeBytes() const;
+    int getWays() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+    static bool parseReplacement(const std::string &name, Replacement &replacement);
+    static std::string getReplacementName(Replacement replacement);
+
+private:
+    struct Line{
+        bool valid = false;
+        uint64_t tag = 0;
+        // Last use under LRU, fill time under FIFO
+        uint64_t stamp = 0;
+    };
+
+    size_t lineBytes;
+    int ways;
+    size_t numSets;
+    Replacement replacement;
+    std::vector<Line> lines;
+    uint64_t clock;
+    FastRandom random;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+};
+
+#endif
@@ -28,7 +28,7 @@ void* FlatMemoryAllocator::allocate(Process* process){
                 return nullptr;
             }
             
-            process->allocatedMemory = allocatedPtr;
+            process->setAllocatedMemory(allocatedPtr);
             activeMem += memReq;
             
             return allocatedPtr;
@@ -40,7 +40,7 @@ void* FlatMemoryAllocator::allocate(Process* process){
 size_t FlatMemoryAllocator::deallocate(Process* process){
     std::lock_guard<std::mutex> lock(allocationMutex);
     
-    void* allocatedMemory = process->allocatedMemory;
+    void* allocatedMemory = process->getAllocatedMemory();
 
     if (allocatedMemory < static_cast<void*>(memory) || allocatedMemory >= static_cast<void*>(memory + maxSize)){
         std::cerr << "Pointer out of bounds for process: " << process->getPID() << std::endl;
@@ -61,6 +61,68 @@ size_t FlatMemoryAllocator::deallocate(Process* process){
     return deallocatedSize;
 }
 
+// The block can only grow in place, into free memory right after it
+size_t FlatMemoryAllocator::grow(Process* process, size_t pages){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = allocationSizes.find(process->getAllocatedMemory());
+    if (it == allocationSizes.end())
+        return 0;
+
+    size_t index = static_cast<char*>(it->first) - memory;
+    size_t extra = pages * process->getMemPerPage();
+    size_t end = index + it->second;
+
+    if (end + extra > maxSize || !canAlloc(end, extra))
+        return 0;
+
+    for (size_t i = end; i < end + extra; ++i){
+        allocationMap[i] = true;
+        memory[i] = 'X';
+    }
+    it->second += extra;
+    allocatedSize += extra;
+    activeMem += extra;
+
+    return extra;
+}
+
+size_t FlatMemoryAllocator::shrink(Process* process, size_t pages){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = allocationSizes.find(process->getAllocatedMemory());
+    if (it == allocationSizes.end())
+        return 0;
+
+    size_t index = static_cast<char*>(it->first) - memory;
+    size_t released = std::min(it->second, pages * process->getMemPerPage());
+    size_t end = index + it->second;
+
+    for (size_t i = end - released; i < end; ++i){
+        allocationMap[i] = false;
+        memory[i] = '.';
+    }
+    it->second -= released;
+    allocatedSize -= released;
+    activeMem -= released;
+
+    return released;
+}
+
+// The block is contiguous, so translation is just the offset from its start
+bool FlatMemoryAllocator::translate(Process* process, size_t address, bool, Translation &translation){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = allocationSizes.find(process->getAllocatedMemory());
+    if (it == allocationSizes.end() || address >= it->second * FRAME_BYTES)
+        return false;
+
+    translation.physicalAddress = static_cast<size_t>(static_cast<char*>(it->first) - memory) * FRAME_BYTES + address;
+    translation.virtualFrame = address / FRAME_BYTES;
+    translation.frame = translation.physicalAddress / FRAME_BYTES;
+    return true;
+}
+
 bool FlatMemoryAllocator::canAlloc(size_t index, size_t size) const{
     for (size_t i = 0; i < size; ++i){
         if (allocationMap[index + i])
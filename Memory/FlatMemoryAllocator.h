@@ -17,6 +17,9 @@ public:
 
     void* allocate(Process* process) override;
     size_t deallocate(Process* process) override;
+    size_t grow(Process* process, size_t pages) override;
+    size_t shrink(Process* process, size_t pages) override;
+    bool translate(Process* process, size_t address, bool write, Translation &translation) override;
     
     size_t getMaxSize() const override;
     size_t getAllocatedSize() const;
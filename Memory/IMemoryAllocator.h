@@ -10,8 +10,30 @@
 
 class IMemoryAllocator{
 public:
+    // Memory sizes are in KB, so one unit of an allocator's map holds this many bytes
+    static constexpr size_t FRAME_BYTES = 1024;
+
+    struct Translation{
+        size_t physicalAddress = 0;
+        // Frame numbers of the access, and the frames the mapping covers (more than 1 for a huge page)
+        size_t virtualFrame = 0;
+        size_t frame = 0;
+        size_t pageFrames = 1;
+        // Page table levels a TLB miss has to walk
+        int walkLevels = 1;
+        // A write found the frame shared with a forked process and gave this one its own copy
+        bool copied = false;
+    };
+
+    virtual ~IMemoryAllocator() = default;
     virtual void *allocate(Process* process) = 0;
     virtual size_t deallocate(Process* process) = 0;
+    // Extends or trims the memory of a process that is already allocated, returning the amount
+    // taken or given back (0 if it could not grow)
+    virtual size_t grow(Process* process, size_t pages) = 0;
+    virtual size_t shrink(Process* process, size_t pages) = 0;
+    // Maps a byte address in a process's memory to a physical one; false if it is not mapped
+    virtual bool translate(Process* process, size_t address, bool write, Translation &translation) = 0;
     virtual size_t getMaxSize() const = 0;
     virtual std::string getName() const = 0;
 };
@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "Memory.h"
+#include "PageMerger.h"
 
 Memory* Memory::sharedInstance = nullptr;
 
@@ -9,7 +10,13 @@ Memory& Memory::getInstance(){
     return instance;
 }
 
-Memory::Memory() : currentOverallMemoryUsage(0), allocator(nullptr) {}
+Memory::Memory() : currentOverallMemoryUsage(0), demandPaging(false), memoryAccessTicks(0), pageFaultTicks(4), pageWriteBackTicks(4), copyOnWriteTicks(4), workingSetWindows(4), swapKB(0), overcommitRatio(0), shmSegments(4), shmSegmentKB(64),
+    numCores(1), tlbEntries(64), tlbWays(4), tlbTagged(true), tlbMissTicks(1),
+    pageTableLevels(2), pageTableBits(9), hugePages(false), cacheEnabled(false), cacheLineBytes(64), cacheReplacement(Cache::LRU),
+    l1CacheKB(32), l1CacheWays(8), l2CacheKB(1024), l2CacheWays(16), l1HitTicks(0), l2HitTicks(1), memoryAccesses(0), pageFaults(0), pageWriteBacks(0), copyOnWriteCopies(0), allocator(nullptr) {
+    defineGroup("batch", 0, 0);
+    defineGroup("interactive", 0, 0);
+}
 
 Memory::~Memory(){
     destroy();
@@ -47,6 +54,77 @@ void Memory::readConfigFile(const std::string& filename){
                 minPagePerProcess = std::stoi(value);
             else if (key == "max-page-per-proc")
                 maxPagePerProcess = std::stoi(value);
+            else if (key == "access-pattern"){
+                if (!AccessPattern::setKind(value))
+                    std::cerr << "Warning: Unknown access pattern '" << value << "', using " << AccessPattern::getKindName() << std::endl;
+            }
+            else if (key == "access-stride")
+                AccessPattern::setStride(std::stoull(value));
+            else if (key == "access-skew")
+                AccessPattern::setSkew(std::stod(value));
+            else if (key == "mem-access-ticks")
+                memoryAccessTicks = std::stoi(value);
+            else if (key == "page-fault-ticks")
+                pageFaultTicks = std::stoi(value);
+            else if (key == "page-writeback-ticks")
+                pageWriteBackTicks = std::stoi(value);
+            else if (key == "cow-copy-ticks")
+                copyOnWriteTicks = std::stoi(value);
+            else if (key == "working-set-windows")
+                workingSetWindows = std::max(1, std::min(std::stoi(value), 8));
+            else if (key == "swap-kb")
+                swapKB = std::max(0, std::stoi(value));
+            else if (key == "overcommit-ratio")
+                overcommitRatio = std::max(0.0, std::stod(value));
+            else if (key == "mem-group"){
+                size_t limitKB = 0, reserveKB = 0;
+                iss >> limitKB >> reserveKB;
+                defineGroup(value, limitKB, reserveKB);
+            }
+            else if (key == "shm-segments")
+                shmSegments = std::stoi(value);
+            else if (key == "shm-segment-kb")
+                shmSegmentKB = std::stoi(value);
+            else if (key == "page-merge")
+                PageMerger::getInstance().setEnabled(std::stoi(value) != 0);
+            else if (key == "page-merge-rate")
+                PageMerger::getInstance().setScanRate(std::stoi(value));
+            else if (key == "num-cpu")
+                numCores = std::stoi(value);
+            else if (key == "tlb-entries")
+                tlbEntries = std::stoi(value);
+            else if (key == "tlb-ways")
+                tlbWays = std::stoi(value);
+            else if (key == "tlb-asid")
+                tlbTagged = std::stoi(value) != 0;
+            else if (key == "tlb-miss-ticks")
+                tlbMissTicks = std::stoi(value);
+            else if (key == "page-table-levels")
+                pageTableLevels = std::stoi(value);
+            else if (key == "page-table-bits")
+                pageTableBits = std::stoi(value);
+            else if (key == "huge-pages")
+                hugePages = std::stoi(value) != 0;
+            else if (key == "cache")
+                cacheEnabled = std::stoi(value) != 0;
+            else if (key == "cache-line-bytes")
+                cacheLineBytes = std::stoi(value);
+            else if (key == "cache-replacement"){
+                if (!Cache::parseReplacement(value, cacheReplacement))
+                    std::cerr << "Warning: Unknown cache replacement '" << value << "', using " << Cache::getReplacementName(cacheReplacement) << std::endl;
+            }
+            else if (key == "cache-l1-kb")
+                l1CacheKB = std::stoi(value);
+            else if (key == "cache-l1-ways")
+                l1CacheWays = std::stoi(value);
+            else if (key == "cache-l2-kb")
+                l2CacheKB = std::stoi(value);
+            else if (key == "cache-l2-ways")
+                l2CacheWays = std::stoi(value);
+            else if (key == "cache-l1-ticks")
+                l1HitTicks = std::stoi(value);
+            else if (key == "cache-l2-ticks")
+                l2HitTicks = std::stoi(value);
         }
         else
             std::cerr << "Warning: Unrecognized parameter in config file: " << key << std::endl;
@@ -55,7 +133,33 @@ void Memory::readConfigFile(const std::string& filename){
     if(minPagePerProcess == 1 && maxPagePerProcess == 1)
         allocator = std::make_unique<FlatMemoryAllocator>(maxOverallMemory);
     else
-        allocator = std::make_unique<PagingMemoryAllocator>(maxOverallMemory);
+        allocator = std::make_unique<PagingMemoryAllocator>(maxOverallMemory, pageTableLevels, pageTableBits, hugePages,
+                                                            shmSegments, static_cast<size_t>(shmSegmentKB));
+
+    // The flat allocator loads a process whole; only paging brings pages in on demand
+    demandPaging = allocator->getName() == "PagingMemoryAllocator";
+
+    segmentWords.clear();
+    for (int segment = 0; segment < shmSegments; ++segment)
+        segmentWords.push_back(std::make_unique<SegmentWords>());
+
+    // With huge pages, a second TLB per core sees the same accesses as base pages, to count the misses they save
+    tlbs.clear();
+    baseTlbs.clear();
+    for (int core = 0; tlbEntries > 0 && core < numCores; ++core){
+        tlbs.push_back(std::make_unique<TLB>(tlbEntries, tlbWays));
+        if (hugePages && demandPaging)
+            baseTlbs.push_back(std::make_unique<TLB>(tlbEntries, tlbWays));
+    }
+
+    // Every core gets a private L1 in front of one L2 shared by all of them
+    l1Caches.clear();
+    l2Cache.reset();
+    if (cacheEnabled){
+        for (int core = 0; core < numCores; ++core)
+            l1Caches.push_back(std::make_unique<Cache>(static_cast<size_t>(l1CacheKB) * 1024, l1CacheWays, cacheLineBytes, cacheReplacement));
+        l2Cache = std::make_unique<Cache>(static_cast<size_t>(l2CacheKB) * 1024, l2CacheWays, cacheLineBytes, cacheReplacement);
+    }
 
     // Create Backing Store text File
     createBackingStore();
@@ -64,7 +168,14 @@ void Memory::readConfigFile(const std::string& filename){
 }
 
 void* Memory::allocateMemory(Process* process){
+    if (!chargeGroup(process)){
+        process->setAllocatedMemory(nullptr);
+        return nullptr;
+    }
+
     void* ptr = allocator->allocate(process);
+    if (!ptr)
+        unchargeGroup(process);
 
     if(allocator->getName() == "FlatMemoryAllocator"){
         if(ptr)
@@ -77,6 +188,18 @@ void* Memory::allocateMemory(Process* process){
         }
     }
 
+    if (ptr)
+        process->pageFlags.assign(process->getNumPage(), demandPaging ? 0 : PAGE_PRESENT);
+
+    process->setAllocatedMemory(ptr);
+
+    // Segments the process had attached before it was swapped out are attached again, if there is room
+    if (ptr){
+        std::vector<int> &segments = process->attachedSegments;
+        segments.erase(std::remove_if(segments.begin(), segments.end(),
+                                      [this, process](int segment){ return !attachSegment(process, segment); }), segments.end());
+    }
+
     return ptr;
 }
 
@@ -85,9 +208,309 @@ void Memory::deallocateMemory(Process* process){
         size_t deallocatedMem = allocator->deallocate(process);
         if (deallocatedMem > 0)
             currentOverallMemoryUsage -= deallocatedMem;
-        else
+        // A forked process whose frames are all still shared frees nothing
+        else if (!demandPaging)
             std::cerr << "Failed to deallocate memory at pointer: " << process->getPID() << std::endl;
+
+        unchargeGroup(process);
+        process->setAllocatedMemory(nullptr);
+    }
+}
+
+// Adds pages to a process's footprint. A process in memory gets the frames right away, charged to
+// its group, and the growth fails if there are none or the group is at its limit; otherwise the
+// larger size is charged at its next allocation, so it only has to fit under the limit.
+bool Memory::growProcess(Process* process, size_t pages){
+    size_t kb = pages * process->getMemPerPage();
+
+    if (process->getAllocatedMemory()){
+        if (!chargeGroupFrames(process, kb, false))
+            return false;
+
+        size_t grown = allocator->grow(process, pages);
+        if (grown == 0){
+            unchargeGroupFrames(process, kb);
+            return false;
+        }
+
+        currentOverallMemoryUsage += grown;
+    }
+    else{
+        std::lock_guard<std::mutex> lock(groupMutex);
+        MemoryGroup &group = memoryGroups[process->memoryGroup];
+        if (group.limitKB > 0 && process->getMemRequired() + kb > group.limitKB){
+            ++group.refusals;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Memory::shrinkProcess(Process* process, size_t pages){
+    if (process->getAllocatedMemory()){
+        currentOverallMemoryUsage -= allocator->shrink(process, pages);
+        unchargeGroupFrames(process, pages * process->getMemPerPage());
+    }
+}
+
+// Called with the process's mutex held, from the core running it
+int Memory::accessMemory(Process* process, uint64_t address, bool write){
+    IMemoryAllocator::Translation translation;
+    if (!allocator->translate(process, address, write, translation))
+        return 0;
+
+    int ticks = chargeAccess(process, translation);
+
+    // Pages added by heap growth since the process was loaded start out not present
+    size_t page = address / (process->getMemPerPage() * IMemoryAllocator::FRAME_BYTES);
+    if (page >= process->pageFlags.size())
+        process->pageFlags.resize(page + 1, demandPaging ? 0 : PAGE_PRESENT);
+
+    uint8_t &flags = process->pageFlags[page];
+    if (!(flags & PAGE_PRESENT)){
+        flags |= PAGE_PRESENT;
+        ++pageFaults;
+        ticks += pageFaultTicks;
+    }
+
+    flags |= PAGE_REFERENCED;
+    if (write)
+        flags |= PAGE_DIRTY;
+
+    return ticks;
+}
+
+// Segment pages are never paged out, so an access to one never faults. Called with the process's
+// mutex held, like accessMemory.
+int Memory::accessSegment(Process* process, int segment, uint64_t offset, uint16_t &var, bool write){
+    auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(allocator.get());
+    IMemoryAllocator::Translation translation;
+    if (!pagingAllocator || !pagingAllocator->translateSegment(process, segment, offset, translation))
+        return 0;
+
+    {
+        SegmentWords &words = *segmentWords[segment];
+        std::lock_guard<std::mutex> lock(words.mutex);
+        if (write)
+            words.words[offset] = var;
+        else{
+            auto it = words.words.find(offset);
+            var = (it != words.words.end()) ? it->second : 0;
+        }
+    }
+
+    return chargeAccess(process, translation);
+}
+
+// Cost of a translated access in the caches or memory, the TLB, and any copy-on-write copy it made
+int Memory::chargeAccess(Process* process, const IMemoryAllocator::Translation &translation){
+    ++memoryAccesses;
+    int ticks = memoryAccessTicks;
+    int coreID = process->getCpuCoreID();
+
+    // With the cache model on, memory is only paid for when the access misses both levels
+    if (coreID >= 0 && coreID < static_cast<int>(l1Caches.size())){
+        ++process->cacheAccesses;
+        ticks = l1HitTicks;
+
+        if (!l1Caches[coreID]->access(translation.physicalAddress)){
+            ++process->l1Misses;
+            ticks += l2HitTicks;
+
+            std::lock_guard<std::mutex> lock(l2Mutex);
+            if (!l2Cache->access(translation.physicalAddress)){
+                ++process->l2Misses;
+                ticks += memoryAccessTicks;
+            }
+        }
+    }
+
+    // The copy is already made, so it is charged to the writer's group even past the limit
+    if (translation.copied){
+        ++copyOnWriteCopies;
+        ++currentOverallMemoryUsage;
+        chargeGroupFrames(process, IMemoryAllocator::FRAME_BYTES / 1024, true);
+        ticks += copyOnWriteTicks;
+    }
+
+    // The TLB caches one entry per page, base or huge, and a miss pays for each level of the walk
+    if (coreID >= 0 && coreID < static_cast<int>(tlbs.size())){
+        uint64_t virtualPage = translation.virtualFrame / translation.pageFrames;
+        if (translation.pageFrames > 1)
+            virtualPage |= TLB::HUGE_PAGE;
+
+        if (!tlbs[coreID]->lookup(process->getPID(), virtualPage, translation.frame / translation.pageFrames))
+            ticks += tlbMissTicks * translation.walkLevels;
+
+        if (coreID < static_cast<int>(baseTlbs.size()))
+            baseTlbs[coreID]->lookup(process->getPID(), translation.virtualFrame, translation.frame);
+    }
+
+    return ticks;
+}
+
+int Memory::getSegmentCount() const{
+    return demandPaging ? shmSegments : 0;
+}
+
+size_t Memory::getSegmentBytes() const{
+    return static_cast<size_t>(shmSegmentKB) * IMemoryAllocator::FRAME_BYTES;
+}
+
+bool Memory::attachSegment(Process* process, int segment){
+    auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(allocator.get());
+    size_t allocated;
+    if (!pagingAllocator || !pagingAllocator->attachSegment(process, segment, allocated))
+        return false;
+
+    currentOverallMemoryUsage += allocated;
+    return true;
+}
+
+void Memory::detachSegment(Process* process, int segment){
+    auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(allocator.get());
+    if (pagingAllocator)
+        currentOverallMemoryUsage -= pagingAllocator->detachSegment(process, segment);
+}
+
+int Memory::writeBackPages(Process* process){
+    std::lock_guard<std::mutex> lock(process->mutex);
+    int dirty = 0;
+
+    for (uint8_t &flags : process->pageFlags){
+        if (flags & PAGE_DIRTY)
+            ++dirty;
+        flags = 0;
+    }
+
+    pageWriteBacks += dirty;
+    return dirty * pageWriteBackTicks;
+}
+
+// Windows are measured in the process's own time: a process that did not run since the last
+// sample keeps its estimate instead of seeing its working set decay while it waits
+size_t Memory::sampleWorkingSet(Process* process){
+    std::lock_guard<std::mutex> lock(process->mutex);
+    if (process->commandCounter == process->sampledCommands)
+        return process->workingSetKB;
+
+    process->sampledCommands = process->commandCounter;
+    uint8_t window = static_cast<uint8_t>(0xFF << (8 - workingSetWindows));
+    size_t pages = 0;
+
+    process->referenceHistory.resize(process->pageFlags.size(), 0);
+    for (size_t page = 0; page < process->pageFlags.size(); ++page){
+        uint8_t &history = process->referenceHistory[page];
+        history = static_cast<uint8_t>((history >> 1) | ((process->pageFlags[page] & PAGE_REFERENCED) ? 0x80 : 0));
+        process->pageFlags[page] &= ~PAGE_REFERENCED;
+
+        if (history & window)
+            ++pages;
+    }
+
+    process->workingSetKB = pages * process->getMemPerPage();
+    return process->workingSetKB;
+}
+
+size_t Memory::getResidentKB(Process* process){
+    if (!process->getAllocatedMemory())
+        return 0;
+
+    auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(allocator.get());
+    if (!pagingAllocator)
+        return process->getMemRequired();
+
+    return pagingAllocator->getPrivateFrames(process) * IMemoryAllocator::FRAME_BYTES / 1024;
+}
+
+void Memory::switchContext(int coreID, Process* process){
+    if (coreID >= 0 && coreID < static_cast<int>(tlbs.size()))
+        tlbs[coreID]->switchTo(process->getPID(), tlbTagged);
+    if (coreID >= 0 && coreID < static_cast<int>(baseTlbs.size()))
+        baseTlbs[coreID]->switchTo(process->getPID(), tlbTagged);
+}
+
+bool Memory::forkMemory(Process* parent, Process* child){
+    auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(allocator.get());
+    if (!pagingAllocator)
+        return false;
+
+    // The shared frames stay charged to the parent and copies are charged as they are made, but
+    // the child is only let in while its whole size would still fit under its group's limit
+    if (isGroupAtLimit(child)){
+        std::lock_guard<std::mutex> lock(groupMutex);
+        ++memoryGroups[child->memoryGroup].refusals;
+        return false;
     }
+
+    std::lock_guard<std::mutex> lock(parent->mutex);
+    void* ptr = pagingAllocator->fork(parent, child);
+    if (!ptr)
+        return false;
+
+    // The child sees the parent's pages as present; they are only dirty for whoever wrote them
+    child->pageFlags = parent->pageFlags;
+    for (uint8_t &flags : child->pageFlags)
+        flags &= ~PAGE_DIRTY;
+
+    child->setAllocatedMemory(ptr);
+
+    std::vector<int> &segments = child->attachedSegments;
+    segments.erase(std::remove_if(segments.begin(), segments.end(),
+                                  [this, child](int segment){ return !attachSegment(child, segment); }), segments.end());
+    return true;
+}
+
+void Memory::reclaimFrames(size_t frames){
+    currentOverallMemoryUsage -= frames;
+}
+
+const TLB* Memory::getTLB(int coreID) const{
+    if (coreID < 0 || coreID >= static_cast<int>(tlbs.size()))
+        return nullptr;
+
+    return tlbs[coreID].get();
+}
+
+const Cache* Memory::getL1Cache(int coreID) const{
+    if (coreID < 0 || coreID >= static_cast<int>(l1Caches.size()))
+        return nullptr;
+
+    return l1Caches[coreID].get();
+}
+
+const Cache* Memory::getL2Cache() const{
+    return l2Cache.get();
+}
+
+// Misses the base-page TLBs took beyond the real ones; negative if huge pages made things worse
+int64_t Memory::getHugePageMissesSaved() const{
+    int64_t saved = 0;
+    for (size_t core = 0; core < baseTlbs.size(); ++core)
+        saved += static_cast<int64_t>(baseTlbs[core]->getMisses()) - static_cast<int64_t>(tlbs[core]->getMisses());
+
+    return saved;
+}
+
+bool Memory::isHugePageTracking() const{
+    return !baseTlbs.empty();
+}
+
+uint64_t Memory::getMemoryAccesses() const{
+    return memoryAccesses;
+}
+
+uint64_t Memory::getPageFaults() const{
+    return pageFaults;
+}
+
+uint64_t Memory::getPageWriteBacks() const{
+    return pageWriteBacks;
+}
+
+uint64_t Memory::getCopyOnWriteCopies() const{
+    return copyOnWriteCopies;
 }
 
 size_t Memory::getCurrentOverallMemoryUsage() const{
@@ -103,6 +526,34 @@ void Memory::getInfo(){
     std::cout << "Min Page Per Process: " << minPagePerProcess << " KB" << std::endl;
     std::cout << "Max Page Per Process: " << maxPagePerProcess << " KB" << std::endl;
     std::cout << "Memory Allocator: " << allocator->getName() << std::endl;
+    std::cout << "Access Pattern: " << AccessPattern::getKindName() << " (stride " << AccessPattern::getStride()
+              << " bytes, skew " << AccessPattern::getSkew() << ")" << std::endl;
+    std::cout << "Memory Access / Page Fault / Write-Back / COW Copy Ticks: " << memoryAccessTicks << " / " << pageFaultTicks
+              << " / " << pageWriteBackTicks << " / " << copyOnWriteTicks << std::endl;
+    if (demandPaging)
+        std::cout << "Page Tables: " << pageTableLevels << " levels of " << pageTableBits << " bits, huge pages "
+                  << (hugePages ? "On (" + std::to_string(1 << pageTableBits) + " KB)" : std::string("Off")) << std::endl;
+    std::cout << "Working Set Windows: " << workingSetWindows << std::endl;
+    for (const MemoryGroup &group : memoryGroups)
+        std::cout << "Memory Group '" << group.name << "': limit " << (group.limitKB > 0 ? std::to_string(group.limitKB) + " KB" : std::string("none"))
+                  << ", reserve " << group.reserveKB << " KB" << std::endl;
+    std::cout << "Swap: " << (swapKB > 0 ? std::to_string(swapKB) + " KB" : std::string("Unbounded")) << ", overcommit "
+              << (overcommitRatio > 0 ? std::to_string(overcommitRatio).substr(0, 4) + "x (" + std::to_string(getCommitLimit()) + " KB)" : std::string("Off")) << std::endl;
+    if (demandPaging)
+        std::cout << "Shared Memory: " << shmSegments << " segments of " << shmSegmentKB << " KB" << std::endl;
+    if (demandPaging)
+        std::cout << "Page Merging: " << (PageMerger::getInstance().isEnabled() ? "On, " + std::to_string(PageMerger::getInstance().getScanRate()) + " pages/s" : std::string("Off")) << std::endl;
+    if (tlbEntries > 0)
+        std::cout << "TLB: " << tlbEntries << " entries, " << tlbWays << "-way, " << (tlbTagged ? "ASID-tagged" : "flushed on switch")
+                  << ", miss costs " << tlbMissTicks << " ticks" << std::endl;
+    else
+        std::cout << "TLB: Off" << std::endl;
+    if (cacheEnabled)
+        std::cout << "Cache: " << l1CacheKB << " KB " << l1CacheWays << "-way L1 per core, " << l2CacheKB << " KB " << l2CacheWays
+                  << "-way shared L2, " << cacheLineBytes << " byte lines, " << Cache::getReplacementName(cacheReplacement)
+                  << ", hit costs " << l1HitTicks << " / " << l2HitTicks << " ticks" << std::endl;
+    else
+        std::cout << "Cache: Off" << std::endl;
 }
 
 void Memory::createBackingStore() {
@@ -135,6 +586,121 @@ size_t Memory::getMaxSize() const{
     return allocator->getMaxSize();
 }
 
+void Memory::defineGroup(const std::string &name, size_t limitKB, size_t reserveKB){
+    int group = findGroup(name);
+    if (group < 0){
+        memoryGroups.emplace_back();
+        memoryGroups.back().name = name;
+        group = static_cast<int>(memoryGroups.size()) - 1;
+    }
+
+    memoryGroups[group].limitKB = limitKB;
+    memoryGroups[group].reserveKB = reserveKB;
+}
+
+int Memory::findGroup(const std::string &name) const{
+    for (size_t group = 0; group < memoryGroups.size(); ++group){
+        if (memoryGroups[group].name == name)
+            return static_cast<int>(group);
+    }
+
+    return -1;
+}
+
+std::vector<Memory::GroupUsage> Memory::getGroupUsage() const{
+    std::lock_guard<std::mutex> lock(groupMutex);
+    std::vector<GroupUsage> usage;
+
+    for (const MemoryGroup &group : memoryGroups)
+        usage.push_back({ group.name, group.usedKB, group.peakKB, group.limitKB, group.reserveKB, group.refusals, group.reclaims });
+
+    return usage;
+}
+
+bool Memory::isGroupAtLimit(const Process* process) const{
+    std::lock_guard<std::mutex> lock(groupMutex);
+    const MemoryGroup &group = memoryGroups[process->memoryGroup];
+
+    return group.limitKB > 0 && group.usedKB + process->getMemRequired() > group.limitKB;
+}
+
+bool Memory::isGroupOverReserve(int group) const{
+    std::lock_guard<std::mutex> lock(groupMutex);
+    return memoryGroups[group].usedKB > memoryGroups[group].reserveKB;
+}
+
+void Memory::recordReclaim(int group){
+    std::lock_guard<std::mutex> lock(groupMutex);
+    ++memoryGroups[group].reclaims;
+}
+
+// Charges the process's size to its group, or refuses if that breaks the group's limit or eats
+// into what other groups have reserved and not yet used
+bool Memory::chargeGroup(Process* process){
+    std::lock_guard<std::mutex> lock(groupMutex);
+    MemoryGroup &group = memoryGroups[process->memoryGroup];
+    size_t size = process->getMemRequired();
+
+    size_t reserved = 0;
+    for (const MemoryGroup &other : memoryGroups){
+        if (&other != &group && other.reserveKB > other.usedKB)
+            reserved += other.reserveKB - other.usedKB;
+    }
+
+    size_t maxSize = getMaxSize();
+    size_t free = maxSize - std::min<size_t>(currentOverallMemoryUsage, maxSize);
+
+    if ((group.limitKB > 0 && group.usedKB + size > group.limitKB) || (reserved > 0 && size + reserved > free)){
+        ++group.refusals;
+        return false;
+    }
+
+    group.usedKB += size;
+    group.peakKB = std::max(group.peakKB, group.usedKB);
+    process->groupChargedKB = size;
+    return true;
+}
+
+void Memory::unchargeGroup(Process* process){
+    std::lock_guard<std::mutex> lock(groupMutex);
+    memoryGroups[process->memoryGroup].usedKB -= process->groupChargedKB;
+    process->groupChargedKB = 0;
+}
+
+bool Memory::chargeGroupFrames(Process* process, size_t kb, bool force){
+    std::lock_guard<std::mutex> lock(groupMutex);
+    MemoryGroup &group = memoryGroups[process->memoryGroup];
+
+    if (!force && group.limitKB > 0 && group.usedKB + kb > group.limitKB){
+        ++group.refusals;
+        return false;
+    }
+
+    group.usedKB += kb;
+    group.peakKB = std::max(group.peakKB, group.usedKB);
+    process->groupChargedKB += kb;
+    return true;
+}
+
+void Memory::unchargeGroupFrames(Process* process, size_t kb){
+    std::lock_guard<std::mutex> lock(groupMutex);
+    kb = std::min(kb, process->groupChargedKB);
+    memoryGroups[process->memoryGroup].usedKB -= kb;
+    process->groupChargedKB -= kb;
+}
+
+size_t Memory::getSwapSize() const{
+    return swapKB;
+}
+
+double Memory::getOvercommitRatio() const{
+    return overcommitRatio;
+}
+
+size_t Memory::getCommitLimit() const{
+    return static_cast<size_t>((getMaxSize() + swapKB) * overcommitRatio);
+}
+
 
 IMemoryAllocator* Memory::getAllocator(){
     return allocator.get();
@@ -7,10 +7,18 @@
 #include <sstream>
 #include <stdexcept>
 #include <memory>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
 
 #include "IMemoryAllocator.h"
 #include "FlatMemoryAllocator.h"
 #include "PagingMemoryAllocator.h"
+#include "AccessPattern.h"
+#include "TLB.h"
+#include "Cache.h"
 
 class Memory{
 public:
@@ -22,13 +30,89 @@ public:
     void readConfigFile(const std::string& filename);
     void* allocateMemory(Process* process);
     void deallocateMemory(Process* process);
+    bool growProcess(Process* process, size_t pages);
+    void shrinkProcess(Process* process, size_t pages);
+
+    // Translates a READ/WRITE address of a process and returns the ticks the access costs. Under
+    // the paging allocator the first touch of a page after the process is loaded is a page fault.
+    int accessMemory(Process* process, uint64_t address, bool write);
+    // Clears the page state of a process about to give up its memory and returns the ticks spent
+    // writing its dirty pages back
+    int writeBackPages(Process* process);
+    // Shifts each page's reference bit into its history and returns the process's working set in
+    // KB: the pages referenced in any of the last working-set-windows samples. Called by the
+    // scheduler once per load-control interval for each resident process.
+    size_t sampleWorkingSet(Process* process);
+    // KB of memory the process holds that ending it would give back: frames it shares with a fork
+    // relative or through page merging stay in use. 0 while it is not resident.
+    size_t getResidentKB(Process* process);
+    // Shared memory segments, only under the paging allocator. An attached process reaches a
+    // segment's words through its own page table; the words themselves live here and outlast the
+    // segment's frames, like a shared memory object that is never unlinked.
+    int getSegmentCount() const;
+    size_t getSegmentBytes() const;
+    bool attachSegment(Process* process, int segment);
+    void detachSegment(Process* process, int segment);
+    int accessSegment(Process* process, int segment, uint64_t offset, uint16_t &var, bool write);
+    // Called by a core before it resumes a process
+    void switchContext(int coreID, Process* process);
+    // Shares the parent's memory with a forked child copy-on-write. False when the parent is not in
+    // memory or the allocator cannot share frames; the child is then loaded like any other process.
+    bool forkMemory(Process* parent, Process* child);
+    // Frames the allocator gave back outside of deallocateMemory/shrinkProcess, e.g. by page merging
+    void reclaimFrames(size_t frames);
+
+    uint64_t getMemoryAccesses() const;
+    uint64_t getPageFaults() const;
+    uint64_t getPageWriteBacks() const;
+    uint64_t getCopyOnWriteCopies() const;
+    // Null when the TLB model is off ('tlb-entries 0')
+    const TLB* getTLB(int coreID) const;
+    // Null when the cache model is off ('cache 0')
+    const Cache* getL1Cache(int coreID) const;
+    const Cache* getL2Cache() const;
+    bool isHugePageTracking() const;
+    int64_t getHugePageMissesSaved() const;
 
     size_t getCurrentOverallMemoryUsage() const;
     int getMinMem() const;
     int getMaxMem() const;
     size_t getMaxSize() const;
+    // KB the backing store holds for swapped-out processes; 0 leaves it unbounded
+    size_t getSwapSize() const;
+    // Memory processes may be admitted against, as a multiple of physical memory plus swap; 0 admits
+    // every process
+    double getOvercommitRatio() const;
+    size_t getCommitLimit() const;
     IMemoryAllocator* getAllocator();
 
+    // Memory groups. A process is charged to its group while it holds memory. An allocation that
+    // would take the group past its limit fails, and so does one that would leave too little free
+    // memory for the unused part of other groups' reservations. Usage above a group's reservation
+    // is what reclaim takes first. Groups are defined with 'mem-group <name> <limit KB> <reserve KB>',
+    // a limit of 0 leaving the group unbounded.
+    static constexpr int BATCH_GROUP = 0;
+    static constexpr int INTERACTIVE_GROUP = 1;
+
+    struct GroupUsage{
+        std::string name;
+        size_t usedKB;
+        size_t peakKB;
+        size_t limitKB;
+        size_t reserveKB;
+        uint64_t refusals;
+        uint64_t reclaims;
+    };
+
+    // -1 if there is no such group
+    int findGroup(const std::string &name) const;
+    std::vector<GroupUsage> getGroupUsage() const;
+    // Whether loading the process would take its group past the group's limit
+    bool isGroupAtLimit(const Process* process) const;
+    bool isGroupOverReserve(int group) const;
+    // Counts a process of the group swapped out to make room
+    void recordReclaim(int group);
+
 private:
     Memory();
     ~Memory();
@@ -41,8 +125,75 @@ private:
     int minPagePerProcess;
     int maxPagePerProcess;
 
-    size_t currentOverallMemoryUsage;
+    std::atomic<size_t> currentOverallMemoryUsage;
+
+    static constexpr uint8_t PAGE_PRESENT = 1;
+    static constexpr uint8_t PAGE_DIRTY = 2;
+    static constexpr uint8_t PAGE_REFERENCED = 4;
+
+    bool demandPaging;
+    int memoryAccessTicks;
+    int pageFaultTicks;
+    int pageWriteBackTicks;
+    int copyOnWriteTicks;
+    int workingSetWindows;
+    int swapKB;
+    double overcommitRatio;
+    int shmSegments;
+    int shmSegmentKB;
+    int numCores;
+    int tlbEntries;
+    int tlbWays;
+    bool tlbTagged;
+    int tlbMissTicks;
+    int pageTableLevels;
+    int pageTableBits;
+    bool hugePages;
+    std::vector<std::unique_ptr<TLB>> tlbs;
+    std::vector<std::unique_ptr<TLB>> baseTlbs;
+    bool cacheEnabled;
+    int cacheLineBytes;
+    Cache::Replacement cacheReplacement;
+    int l1CacheKB;
+    int l1CacheWays;
+    int l2CacheKB;
+    int l2CacheWays;
+    int l1HitTicks;
+    int l2HitTicks;
+    std::vector<std::unique_ptr<Cache>> l1Caches;
+    std::unique_ptr<Cache> l2Cache;
+    std::mutex l2Mutex;
+    std::atomic<uint64_t> memoryAccesses;
+    std::atomic<uint64_t> pageFaults;
+    std::atomic<uint64_t> pageWriteBacks;
+    std::atomic<uint64_t> copyOnWriteCopies;
+
+    struct SegmentWords{
+        std::mutex mutex;
+        std::unordered_map<uint64_t, uint16_t> words;
+    };
+    std::vector<std::unique_ptr<SegmentWords>> segmentWords;
+
+    struct MemoryGroup{
+        std::string name;
+        size_t limitKB = 0;
+        size_t reserveKB = 0;
+        size_t usedKB = 0;
+        size_t peakKB = 0;
+        uint64_t refusals = 0;
+        uint64_t reclaims = 0;
+    };
+    std::vector<MemoryGroup> memoryGroups;
+    mutable std::mutex groupMutex;
+
+    void defineGroup(const std::string &name, size_t limitKB, size_t reserveKB);
+    bool chargeGroup(Process* process);
+    void unchargeGroup(Process* process);
+    // Charges frames a process gains while in memory; refused past the group's limit unless forced
+    bool chargeGroupFrames(Process* process, size_t kb, bool force);
+    void unchargeGroupFrames(Process* process, size_t kb);
 
+    int chargeAccess(Process* process, const IMemoryAllocator::Translation &translation);
     void createBackingStore();
 
     std::unique_ptr<IMemoryAllocator> allocator;
@@ -0,0 +1,249 @@
+#include <chrono>
+#include <algorithm>
+
+#include "PageMerger.h"
+#include "Memory.h"
+#include "PagingMemoryAllocator.h"
+#include "../Processor/ProcessTable.h"
+#include "../Processor/Process.h"
+
+PageMerger* PageMerger::sharedInstance = nullptr;
+
+PageMerger& PageMerger::getInstance(){
+    if (!sharedInstance)
+        initialize();
+
+    return *sharedInstance;
+}
+
+void PageMerger::initialize(){
+    if (!sharedInstance)
+        sharedInstance = new PageMerger();
+}
+
+void PageMerger::destroy(){
+    if (sharedInstance){
+        delete sharedInstance;
+        sharedInstance = nullptr;
+    }
+}
+
+PageMerger::PageMerger() : enabled(false), running(false), scanRate(10000), cursor(0),
+    pagesScanned(0), pagesMerged(0), passes(0) {}
+
+PageMerger::~PageMerger(){
+    stop();
+}
+
+void PageMerger::setEnabled(bool enabled){
+    std::lock_guard<std::mutex> lock(mutex);
+    this->enabled = enabled;
+}
+
+bool PageMerger::isEnabled() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return enabled;
+}
+
+void PageMerger::setScanRate(int framesPerSecond){
+    std::lock_guard<std::mutex> lock(mutex);
+    scanRate = std::max(1, framesPerSecond);
+}
+
+int PageMerger::getScanRate() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return scanRate;
+}
+
+void PageMerger::start(){
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled || running)
+        return;
+
+    running = true;
+    scannerThread = std::thread(&PageMerger::run, this);
+}
+
+void PageMerger::stop(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running)
+            return;
+        running = false;
+    }
+
+    wakeup.notify_all();
+    if (scannerThread.joinable())
+        scannerThread.join();
+}
+
+void PageMerger::run(){
+    while (true){
+        size_t budget;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait_for(lock, std::chrono::milliseconds(SCAN_INTERVAL_MS), [this](){ return !running; });
+            if (!running)
+                break;
+
+            budget = std::max<size_t>(1, static_cast<size_t>(scanRate) * SCAN_INTERVAL_MS / 1000);
+        }
+
+        auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(Memory::getInstance().getAllocator());
+        if (pagingAllocator)
+            scan(*pagingAllocator, budget);
+    }
+}
+
+// Walks the process table from where the last interval stopped, a whole process at a time, until
+// the budget of frames is used up. Wrapping around the table ends a pass.
+void PageMerger::scan(PagingMemoryAllocator &allocator, size_t budget){
+    ProcessTable& table = ProcessTable::getInstance();
+    uint32_t end = table.size();
+    size_t scanned = 0;
+
+    for (uint32_t visited = 0; visited < end && scanned < budget; ++visited){
+        if (cursor >= end){
+            cursor = 0;
+            unstableFrames.clear();
+            ++passes;
+        }
+
+        std::shared_ptr<Process> process = table.getSharedProcess(cursor++);
+        if (process && process->getAllocatedMemory())
+            scanned += scanProcess(allocator, process);
+    }
+}
+
+size_t PageMerger::scanProcess(PagingMemoryAllocator &allocator, const std::shared_ptr<Process> &process){
+    ProcessTable& table = ProcessTable::getInstance();
+    Memory& memory = Memory::getInstance();
+
+    // Holding the process's mutex keeps its contents still; WRITE takes it too
+    std::lock_guard<std::mutex> lock(process->mutex);
+    std::vector<uint64_t> frames;
+    if (!allocator.getMappedFrames(process.get(), frames))
+        return 0;
+
+    std::vector<uint64_t> hashes = hashFrames(allocator, *process, frames.size());
+    bool freed = false;
+
+    for (size_t virtualFrame = 0; virtualFrame < frames.size(); ++virtualFrame){
+        if (frames[virtualFrame] == PageTable::NO_FRAME)
+            continue;
+
+        ++pagesScanned;
+        uint64_t hash = hashes[virtualFrame];
+
+        auto stable = stableFrames.find(hash);
+        if (stable != stableFrames.end()){
+            if (stable->second.frame == frames[virtualFrame])
+                continue;
+
+            // Equal hashes do not prove equal contents, so the words are compared before merging
+            if (stable->second.words == frameWords(allocator, *process, virtualFrame)){
+                if (allocator.mergeFrame(process.get(), virtualFrame, stable->second.frame, stable->second.stamp, freed)){
+                    ++pagesMerged;
+                    if (freed)
+                        memory.reclaimFrames(1);
+                    continue;
+                }
+
+                // The frame was copied away from or freed since it was merged
+                stableFrames.erase(stable);
+            }
+        }
+
+        auto candidate = unstableFrames.find(hash);
+        if (candidate == unstableFrames.end()){
+            unstableFrames[hash] = { process->getSlot(), process->getPID(), virtualFrame };
+            continue;
+        }
+
+        // The other frame may have been written since it was hashed, and equal hashes do not prove
+        // equal contents either, so the two frames' words are compared first
+        Candidate other = candidate->second;
+        std::shared_ptr<Process> owner = other.slot == process->getSlot() ? process : table.getSharedProcess(other.slot);
+        unstableFrames[hash] = { process->getSlot(), process->getPID(), virtualFrame };
+        if (!owner || owner->getPID() != other.pid)
+            continue;
+
+        std::unique_lock<std::mutex> ownerLock(owner->mutex, std::defer_lock);
+        if (owner != process){
+            ownerLock.lock();
+            if (!owner->getAllocatedMemory())
+                continue;
+        }
+
+        FrameWords words = frameWords(allocator, *process, virtualFrame);
+        if (words != frameWords(allocator, *owner, other.virtualFrame))
+            continue;
+
+        size_t frame;
+        uint64_t stamp = allocator.mergeFrame(process.get(), virtualFrame, owner.get(), other.virtualFrame, frame, freed);
+        if (stamp == 0)
+            continue;
+
+        stableFrames[hash] = { frame, stamp, std::move(words) };
+        unstableFrames.erase(hash);
+        ++pagesMerged;
+        if (freed)
+            memory.reclaimFrames(1);
+    }
+
+    return frames.size();
+}
+
+// Content hash of each of the first virtualFrames frames of a process, from the words WRITE stored
+// in them. Words are combined by addition so the map's iteration order does not matter, and zero
+// words are skipped since a frame reads as zero wherever nothing was written. Called with the
+// process's mutex held.
+std::vector<uint64_t> PageMerger::hashFrames(PagingMemoryAllocator &allocator, const Process &process, size_t virtualFrames) const{
+    static constexpr uint64_t EMPTY_FRAME = 0x9E3779B97F4A7C15ULL;
+    std::vector<uint64_t> hashes(virtualFrames, EMPTY_FRAME);
+    size_t memPerPage = process.getMemPerPage();
+
+    for (const auto &word : process.memoryWords){
+        if (word.second == 0)
+            continue;
+
+        size_t virtualFrame = allocator.getVirtualFrame(memPerPage, word.first);
+        if (virtualFrame >= virtualFrames)
+            continue;
+
+        // splitmix64 finalizer over the word's offset in its frame and its value
+        uint64_t x = ((word.first % IMemoryAllocator::FRAME_BYTES) << 16) | word.second;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        hashes[virtualFrame] += x ^ (x >> 31);
+    }
+
+    return hashes;
+}
+
+// The words WRITE stored in one frame of a process, as hashFrames sees them. Called with the
+// process's mutex held.
+PageMerger::FrameWords PageMerger::frameWords(PagingMemoryAllocator &allocator, const Process &process, size_t virtualFrame) const{
+    FrameWords words;
+    size_t memPerPage = process.getMemPerPage();
+
+    for (const auto &word : process.memoryWords){
+        if (word.second != 0 && allocator.getVirtualFrame(memPerPage, word.first) == virtualFrame)
+            words.push_back({ word.first % IMemoryAllocator::FRAME_BYTES, word.second });
+    }
+
+    std::sort(words.begin(), words.end());
+    return words;
+}
+
+uint64_t PageMerger::getPagesScanned() const{
+    return pagesScanned;
+}
+
+uint64_t PageMerger::getPagesMerged() const{
+    return pagesMerged;
+}
+
+uint64_t PageMerger::getPasses() const{
+    return passes;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef PAGE_MERGER_H
+#define PAGE_MERGER_H
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+class Process;
+class PagingMemoryAllocator;
+
+// Background thread that hashes the frames of resident processes and merges frames with identical
+// contents into one copy-on-write frame, like same-page merging in a real kernel. Frames already
+// merged are kept in a stable table, since copy-on-write stops their contents from changing; frames
+// seen once during a pass wait in an unstable table until a match is found or the pass ends.
+// Enabled with the 'page-merge' config key under the paging allocator.
+class PageMerger{
+public:
+    static PageMerger& getInstance();
+    static void initialize();
+    static void destroy();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    // Frames hashed per second
+    void setScanRate(int framesPerSecond);
+    int getScanRate() const;
+
+    void start();
+    void stop();
+
+    uint64_t getPagesScanned() const;
+    uint64_t getPagesMerged() const;
+    uint64_t getPasses() const;
+
+private:
+    PageMerger();
+    ~PageMerger();
+    PageMerger(const PageMerger&) = delete;
+    PageMerger& operator=(const PageMerger&) = delete;
+
+    static constexpr int SCAN_INTERVAL_MS = 100;
+
+    // Offset in the frame and value of each non-zero word, in offset order
+    using FrameWords = std::vector<std::pair<uint64_t, uint16_t>>;
+
+    struct StableFrame{
+        size_t frame;
+        uint64_t stamp;
+        // Copy-on-write keeps a merged frame's contents, so they are kept to compare against
+        FrameWords words;
+    };
+
+    struct Candidate{
+        uint32_t slot;
+        int pid;
+        size_t virtualFrame;
+    };
+
+    void run();
+    void scan(PagingMemoryAllocator &allocator, size_t budget);
+    size_t scanProcess(PagingMemoryAllocator &allocator, const std::shared_ptr<Process> &process);
+    std::vector<uint64_t> hashFrames(PagingMemoryAllocator &allocator, const Process &process, size_t virtualFrames) const;
+    FrameWords frameWords(PagingMemoryAllocator &allocator, const Process &process, size_t virtualFrame) const;
+
+    bool enabled;
+    bool running;
+    int scanRate;
+    std::thread scannerThread;
+
+    // Only touched by the scanner thread
+    uint32_t cursor;
+    std::unordered_map<uint64_t, StableFrame> stableFrames;
+    std::unordered_map<uint64_t, Candidate> unstableFrames;
+
+    std::atomic<uint64_t> pagesScanned;
+    std::atomic<uint64_t> pagesMerged;
+    std::atomic<uint64_t> passes;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeup;
+    static PageMerger* sharedInstance;
+};
+
+#endif
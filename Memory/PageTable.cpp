@@ -0,0 +1,158 @@
+#include <algorithm>
+
+#include "PageTable.h"
+
+PageTable::PageTable(int levels, int bits) : tableCount(0), hugePages(0){
+    this->levels = std::max(2, std::min(levels, 4));
+    this->bits = std::max(1, std::min(bits, 12));
+    root = std::make_unique<Node>();
+}
+
+size_t PageTable::indexAt(uint64_t virtualFrame, int level) const{
+    int shift = bits * (levels - 1 - level);
+    return static_cast<size_t>((virtualFrame >> shift) & ((1ULL << bits) - 1));
+}
+
+// Node at the given depth on the path to virtualFrame, creating missing tables on the way if asked
+PageTable::Node* PageTable::walk(uint64_t virtualFrame, int depth, bool create){
+    size_t entries = static_cast<size_t>(1) << bits;
+    Node* node = root.get();
+
+    if (node->entries.empty()){
+        if (!create)
+            return nullptr;
+
+        node->entries.assign(entries, 0);
+        node->children.resize(entries);
+        ++tableCount;
+    }
+
+    for (int level = 0; level < depth; ++level){
+        std::unique_ptr<Node> &child = node->children[indexAt(virtualFrame, level)];
+        if (!child){
+            if (!create)
+                return nullptr;
+
+            child = std::make_unique<Node>();
+            child->entries.assign(entries, 0);
+            if (level + 1 < levels - 1)
+                child->children.resize(entries);
+            ++tableCount;
+        }
+        node = child.get();
+    }
+
+    return node;
+}
+
+bool PageTable::map(uint64_t virtualFrame, uint64_t frame){
+    if (virtualFrame >= getCoverage())
+        return false;
+
+    // Remapping inside a huge page splits it, so the rest of it stays mapped
+    Node* parent = walk(virtualFrame, levels - 2, true);
+    if (parent->entries[indexAt(virtualFrame, levels - 2)] != 0)
+        unmap(virtualFrame);
+
+    Node* leaf = walk(virtualFrame, levels - 1, true);
+    leaf->entries[indexAt(virtualFrame, levels - 1)] = frame + 1;
+    return true;
+}
+
+bool PageTable::mapHuge(uint64_t virtualFrame, uint64_t frame){
+    if (virtualFrame >= getCoverage())
+        return false;
+
+    Node* parent = walk(virtualFrame, levels - 2, true);
+    size_t index = indexAt(virtualFrame, levels - 2);
+
+    if (parent->children[index]){
+        parent->children[index].reset();
+        --tableCount;
+    }
+    if (parent->entries[index] == 0)
+        ++hugePages;
+
+    parent->entries[index] = frame + 1;
+    return true;
+}
+
+uint64_t PageTable::unmap(uint64_t virtualFrame){
+    if (virtualFrame >= getCoverage())
+        return NO_FRAME;
+
+    Node* parent = walk(virtualFrame, levels - 2, false);
+    if (!parent)
+        return NO_FRAME;
+
+    size_t index = indexAt(virtualFrame, levels - 2);
+    if (parent->entries[index] != 0){
+        uint64_t base = parent->entries[index] - 1;
+        parent->entries[index] = 0;
+        --hugePages;
+
+        Node* leaf = walk(virtualFrame, levels - 1, true);
+        for (size_t i = 0; i < leaf->entries.size(); ++i)
+            leaf->entries[i] = base + i + 1;
+    }
+
+    Node* leaf = parent->children[index].get();
+    if (!leaf)
+        return NO_FRAME;
+
+    uint64_t &entry = leaf->entries[indexAt(virtualFrame, levels - 1)];
+    uint64_t frame = entry == 0 ? NO_FRAME : entry - 1;
+    entry = 0;
+    return frame;
+}
+
+bool PageTable::lookup(uint64_t virtualFrame, Translation &translation) const{
+    if (virtualFrame >= getCoverage() || root->entries.empty())
+        return false;
+
+    const Node* node = root.get();
+    for (int level = 0; level < levels - 1; ++level){
+        size_t index = indexAt(virtualFrame, level);
+
+        if (level == levels - 2 && node->entries[index] != 0){
+            translation.frame = node->entries[index] - 1 + (virtualFrame & (getHugeFrames() - 1));
+            translation.huge = true;
+            translation.levels = levels - 1;
+            return true;
+        }
+
+        node = node->children[index].get();
+        if (!node)
+            return false;
+    }
+
+    uint64_t entry = node->entries[indexAt(virtualFrame, levels - 1)];
+    if (entry == 0)
+        return false;
+
+    translation.frame = entry - 1;
+    translation.huge = false;
+    translation.levels = levels;
+    return true;
+}
+
+uint64_t PageTable::getHugeFrames() const{
+    return 1ULL << bits;
+}
+
+uint64_t PageTable::getCoverage() const{
+    return 1ULL << (bits * levels);
+}
+
+size_t PageTable::getTableCount() const{
+    return tableCount;
+}
+
+// Each entry is a 64-bit word, as in a hardware page table
+size_t PageTable::getTableBytes() const{
+    return tableCount * (static_cast<size_t>(1) << bits) * sizeof(uint64_t);
+}
+
+size_t PageTable::getHugePages() const{
+    return hugePages;
+}
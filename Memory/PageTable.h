@@ -0,0 +1,56 @@
+#pragma once
+#ifndef PAGE_TABLE_H
+#define PAGE_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+// Radix page table of one process, mapping virtual frame numbers to physical frames (both in
+// 1 KB units). Every level indexes 'bits' bits of the frame number, so tables are only created
+// for the parts of the address space in use. One level above the leaves, an entry can map a whole
+// leaf table's worth of contiguous frames as a huge page.
+class PageTable{
+public:
+    static constexpr uint64_t NO_FRAME = ~0ULL;
+
+    struct Translation{
+        uint64_t frame;
+        bool huge;
+        int levels;
+    };
+
+    PageTable(int levels, int bits);
+
+    bool map(uint64_t virtualFrame, uint64_t frame);
+    // Both frame numbers must be aligned to getHugeFrames()
+    bool mapHuge(uint64_t virtualFrame, uint64_t frame);
+    // Returns the frame that was mapped, or NO_FRAME. A huge page covering it is split first.
+    uint64_t unmap(uint64_t virtualFrame);
+    bool lookup(uint64_t virtualFrame, Translation &translation) const;
+
+    uint64_t getHugeFrames() const;
+    uint64_t getCoverage() const;
+    size_t getTableCount() const;
+    size_t getTableBytes() const;
+    size_t getHugePages() const;
+
+private:
+    // Entries hold frame + 1 for a mapping (huge above the leaf level), 0 when empty
+    struct Node{
+        std::vector<uint64_t> entries;
+        std::vector<std::unique_ptr<Node>> children;
+    };
+
+    size_t indexAt(uint64_t virtualFrame, int level) const;
+    Node* walk(uint64_t virtualFrame, int depth, bool create);
+
+    int levels;
+    int bits;
+    std::unique_ptr<Node> root;
+    size_t tableCount;
+    size_t hugePages;
+};
+
+#endif
@@ -4,7 +4,9 @@
 
 #include "PagingMemoryAllocator.h"
 
-PagingMemoryAllocator::PagingMemoryAllocator(size_t maxSize) : maxSize(maxSize){
+PagingMemoryAllocator::PagingMemoryAllocator(size_t maxSize, int pageTableLevels, int pageTableBits, bool hugePages, int numSegments, size_t segmentFrames)
+    : maxSize(maxSize), mergeStamp(0), pageTableLevels(pageTableLevels), pageTableBits(pageTableBits), hugePages(hugePages),
+    segmentFrames(segmentFrames), segments(std::max(0, numSegments)){
     for (size_t i = 0; i < maxSize; ++i) 
         freeFrameList.push_back(i);
 }
@@ -26,22 +28,68 @@ void* PagingMemoryAllocator::allocate(Process* process) {
     if (totalMemReqProc > freeFrameList.size())
         return nullptr;
 
-    std::vector<size_t> frameIndices = allocateFrames(numPages, pageSize, processID);
+    MappedProcess mapped = { std::make_unique<PageTable>(pageTableLevels, pageTableBits), totalMemReqProc, {} };
+    if (totalMemReqProc > getAddressLimit(*mapped.table)){
+        std::cerr << "Allocation Failed. Process " << processID << " does not fit in its page table." << std::endl;
+        return nullptr;
+    }
+
+    // Aligned stretches of the address space get a huge page when a contiguous run of frames is free
+    size_t virtualFrame = 0;
+    if (hugePages){
+        size_t hugeFrames = mapped.table->getHugeFrames();
+        size_t start;
+
+        for (; virtualFrame + hugeFrames <= totalMemReqProc && findFreeRun(hugeFrames, start); virtualFrame += hugeFrames){
+            for (size_t frame = start; frame < start + hugeFrames; ++frame)
+                frameMap[frame] = 1;
+
+            mapped.table->mapHuge(virtualFrame, start);
+        }
+
+        if (virtualFrame > 0)
+            freeFrameList.erase(std::remove_if(freeFrameList.begin(), freeFrameList.end(),
+                                               [this](size_t frame){ return frameMap.count(frame) > 0; }), freeFrameList.end());
+    }
 
-    if (frameIndices.empty()){
+    std::vector<size_t> frameIndices = allocateFrames(totalMemReqProc - virtualFrame, 1);
+
+    if (frameIndices.size() < totalMemReqProc - virtualFrame){
         std::cerr << "Allocation Failed. Could not allocate frames." << std::endl;
         return nullptr;
     }
     else{
+        for (size_t frame : frameIndices)
+            mapped.table->map(virtualFrame++, frame);
+
+        PageTable::Translation first = { 0, false, 0 };
+        mapped.table->lookup(0, first);
+
         // Active Memory
         size_t activeMem = numPages * memPerPage;
         activeMemMap.insert({processID, activeMem});
+        pageTables[processID] = std::move(mapped);
 
-        return reinterpret_cast<void*>(frameIndices.front());
+        // Offset by one so a process starting at frame 0 is not mistaken for a failed allocation
+        return reinterpret_cast<void*>(first.frame + 1);
     }
 }
 
-std::vector<size_t> PagingMemoryAllocator::allocateFrames(size_t numPages, size_t pageSize, size_t processID) {
+// Lowest free run of count frames aligned to count, the way a huge page has to be backed
+bool PagingMemoryAllocator::findFreeRun(size_t count, size_t &start) const{
+    for (start = 0; start + count <= maxSize; start += count){
+        size_t frame = start;
+        while (frame < start + count && frameMap.count(frame) == 0)
+            ++frame;
+
+        if (frame == start + count)
+            return true;
+    }
+
+    return false;
+}
+
+std::vector<size_t> PagingMemoryAllocator::allocateFrames(size_t numPages, size_t pageSize) {
     std::vector<size_t> allocatedFrames;
 
     for (size_t i = 0; i < numPages; ++i){
@@ -53,7 +101,7 @@ std::vector<size_t> PagingMemoryAllocator::allocateFrames(size_t numPages, size_
 
             size_t frameIndex = freeFrameList.back();
             freeFrameList.pop_back();
-            frameMap[frameIndex] = processID;
+            frameMap[frameIndex] = 1;
 
             allocatedFrames.push_back(frameIndex);
         }
@@ -62,27 +110,431 @@ std::vector<size_t> PagingMemoryAllocator::allocateFrames(size_t numPages, size_
     return allocatedFrames;
 }
 
+// Drops one process's reference to a frame, freeing it with the last one. A merged frame left with
+// a single reference is writable in place again, so it stops being a merge target.
+bool PagingMemoryAllocator::releaseFrame(size_t frame){
+    auto it = frameMap.find(frame);
+    if (it == frameMap.end())
+        return false;
+
+    if (--it->second <= 1)
+        mergedFrames.erase(frame);
+    if (it->second > 0)
+        return false;
+
+    frameMap.erase(it);
+    freeFrameList.push_back(frame);
+    return true;
+}
+
+// Returns the frames actually freed; ones still mapped by a forked relative stay in use
 size_t PagingMemoryAllocator::deallocate(Process* process){
     std::lock_guard<std::mutex> lock(allocationMutex);
 
     size_t processID = process->getPID();
-    std::vector<size_t> deallocatedFrames;
-    auto it = frameMap.begin();
-
-    while (it != frameMap.end()){
-        if (it->second == processID){
-            size_t frameIndex = it->first;
-            freeFrameList.push_back(frameIndex);
-            deallocatedFrames.push_back(frameIndex);
-            it = frameMap.erase(it);
+    size_t freed = 0;
+    auto it = pageTables.find(processID);
+
+    if (it != pageTables.end()){
+        for (size_t virtualFrame = 0; virtualFrame < it->second.virtualFrames; ++virtualFrame){
+            uint64_t frameIndex = it->second.table->unmap(virtualFrame);
+            if (frameIndex != PageTable::NO_FRAME && releaseFrame(frameIndex))
+                ++freed;
         }
-        else
-            ++it;
+
+        for (int segment : it->second.segments)
+            freed += unmapSegment(it->second, segment);
     }
 
     activeMemMap.erase(processID);
+    pageTables.erase(processID);
+
+    return freed;
+}
+
+void* PagingMemoryAllocator::fork(Process* parent, Process* child){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(parent->getPID());
+    if (it == pageTables.end())
+        return nullptr;
+
+    const PageTable &source = *it->second.table;
+    size_t hugeFrames = source.getHugeFrames();
+    MappedProcess mapped = { std::make_unique<PageTable>(pageTableLevels, pageTableBits), it->second.virtualFrames, {} };
+    PageTable::Translation mapping;
+
+    // Huge pages stay huge in the child; each frame under them gains a reference all the same
+    for (size_t virtualFrame = 0; virtualFrame < mapped.virtualFrames; ){
+        if (!source.lookup(virtualFrame, mapping)){
+            ++virtualFrame;
+            continue;
+        }
+
+        if (mapping.huge && virtualFrame % hugeFrames == 0){
+            mapped.table->mapHuge(virtualFrame, mapping.frame);
+            for (size_t frame = mapping.frame; frame < mapping.frame + hugeFrames; ++frame)
+                ++frameMap[frame];
+            virtualFrame += hugeFrames;
+        }
+        else{
+            mapped.table->map(virtualFrame, mapping.frame);
+            ++frameMap[mapping.frame];
+            ++virtualFrame;
+        }
+    }
+
+    PageTable::Translation first = { 0, false, 0 };
+    mapped.table->lookup(0, first);
+
+    // The child's active memory is already counted under the parent until it grows or copies pages
+    pageTables[child->getPID()] = std::move(mapped);
+
+    return reinterpret_cast<void*>(first.frame + 1);
+}
+
+// New pages go at the top of the address space, as base pages
+size_t PagingMemoryAllocator::grow(Process* process, size_t pages){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    size_t processID = process->getPID();
+    size_t pageSize = setPageSize(process->getMemPerPage());
+    auto it = pageTables.find(processID);
+
+    if (it == pageTables.end() || pages * pageSize > freeFrameList.size() ||
+        it->second.virtualFrames + pages * pageSize > getAddressLimit(*it->second.table))
+        return 0;
+
+    std::vector<size_t> frameIndices = allocateFrames(pages, pageSize);
+    activeMemMap[processID] += pages * process->getMemPerPage();
+
+    for (size_t frame : frameIndices)
+        it->second.table->map(it->second.virtualFrames++, frame);
+
+    return frameIndices.size();
+}
+
+// Pages come off the top of the address space, splitting a huge page if one covers them
+size_t PagingMemoryAllocator::shrink(Process* process, size_t pages){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    size_t processID = process->getPID();
+    size_t framesToFree = pages * setPageSize(process->getMemPerPage());
+    auto it = pageTables.find(processID);
+    size_t freed = 0;
+
+    while (it != pageTables.end() && it->second.virtualFrames > 0 && freed < framesToFree){
+        uint64_t frameIndex = it->second.table->unmap(--it->second.virtualFrames);
+        if (frameIndex == PageTable::NO_FRAME)
+            continue;
+
+        if (releaseFrame(frameIndex))
+            ++freed;
+    }
+
+    size_t &active = activeMemMap[processID];
+    active -= std::min(active, pages * process->getMemPerPage());
+
+    return freed;
+}
+
+// A page spans setPageSize(memPerPage) frames of the address space, so the page number picks the
+// run and the offset the frame in it; the page table then gives the physical frame
+bool PagingMemoryAllocator::translate(Process* process, size_t address, bool write, Translation &translation){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(process->getPID());
+    size_t pageBytes = process->getMemPerPage() * FRAME_BYTES;
+    if (it == pageTables.end() || pageBytes == 0)
+        return false;
+
+    size_t offset = address % pageBytes;
+    size_t virtualFrame = getVirtualFrame(process->getMemPerPage(), address);
+
+    PageTable::Translation mapping;
+    if (!it->second.table->lookup(virtualFrame, mapping))
+        return false;
+
+    // Writing a shared frame moves this process onto a private copy, splitting a huge page around it.
+    // With no frame free for the copy the write goes to the shared frame uncounted.
+    if (write && frameMap[mapping.frame] > 1 && !freeFrameList.empty()){
+        size_t copy = freeFrameList.back();
+        freeFrameList.pop_back();
+        frameMap[copy] = 1;
+        releaseFrame(mapping.frame);
+
+        it->second.table->map(virtualFrame, copy);
+        it->second.table->lookup(virtualFrame, mapping);
+        activeMemMap[process->getPID()] += FRAME_BYTES / 1024;
+        translation.copied = true;
+    }
+
+    translation.physicalAddress = mapping.frame * FRAME_BYTES + offset % FRAME_BYTES;
+    translation.virtualFrame = virtualFrame;
+    translation.frame = mapping.frame;
+    translation.pageFrames = mapping.huge ? it->second.table->getHugeFrames() : 1;
+    translation.walkLevels = mapping.levels;
+    return true;
+}
+
+bool PagingMemoryAllocator::getPageTableInfo(Process* process, size_t &tables, size_t &bytes, size_t &hugePageCount){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(process->getPID());
+    if (it == pageTables.end())
+        return false;
+
+    tables = it->second.table->getTableCount();
+    bytes = it->second.table->getTableBytes();
+    hugePageCount = it->second.table->getHugePages();
+    return true;
+}
+
+// Totals over the resident processes; flatBytes is what one array entry per frame of each
+// address space would take instead
+void PagingMemoryAllocator::getPageTableTotals(size_t &bytes, size_t &flatBytes, size_t &hugePageCount){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    bytes = flatBytes = hugePageCount = 0;
+
+    for (const auto &pair : pageTables){
+        bytes += pair.second.table->getTableBytes();
+        flatBytes += pair.second.virtualFrames * sizeof(uint64_t);
+        hugePageCount += pair.second.table->getHugePages();
+    }
+}
+
+// Process memory may not reach into the slots reserved for shared segments
+size_t PagingMemoryAllocator::getAddressLimit(const PageTable &table) const{
+    size_t reserved = segments.size() * segmentFrames;
+    return table.getCoverage() > reserved ? table.getCoverage() - reserved : 0;
+}
+
+size_t PagingMemoryAllocator::getSegmentBase(const PageTable &table, int segment) const{
+    return table.getCoverage() - (segment + 1) * segmentFrames;
+}
 
-    return deallocatedFrames.size();
+bool PagingMemoryAllocator::attachSegment(Process* process, int segment, size_t &allocated){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    allocated = 0;
+
+    auto it = pageTables.find(process->getPID());
+    if (it == pageTables.end() || segment < 0 || segment >= static_cast<int>(segments.size()) ||
+        getAddressLimit(*it->second.table) == 0)
+        return false;
+
+    std::vector<int> &attached = it->second.segments;
+    if (std::find(attached.begin(), attached.end(), segment) != attached.end())
+        return true;
+
+    // Each attached process holds one reference to every frame of the segment
+    Segment &shared = segments[segment];
+    if (shared.frames.empty()){
+        if (freeFrameList.size() < segmentFrames)
+            return false;
+
+        shared.frames = allocateFrames(segmentFrames, 1);
+        allocated = shared.frames.size();
+    }
+    else{
+        for (size_t frame : shared.frames)
+            ++frameMap[frame];
+    }
+
+    size_t base = getSegmentBase(*it->second.table, segment);
+    for (size_t i = 0; i < shared.frames.size(); ++i)
+        it->second.table->map(base + i, shared.frames[i]);
+
+    ++shared.attached;
+    attached.push_back(segment);
+    return true;
+}
+
+size_t PagingMemoryAllocator::detachSegment(Process* process, int segment){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(process->getPID());
+    if (it == pageTables.end())
+        return 0;
+
+    std::vector<int> &attached = it->second.segments;
+    auto position = std::find(attached.begin(), attached.end(), segment);
+    if (position == attached.end())
+        return 0;
+
+    attached.erase(position);
+    return unmapSegment(it->second, segment);
+}
+
+// Called with allocationMutex held
+size_t PagingMemoryAllocator::unmapSegment(MappedProcess &mapped, int segment){
+    Segment &shared = segments[segment];
+    size_t base = getSegmentBase(*mapped.table, segment);
+    size_t freed = 0;
+
+    for (size_t i = 0; i < shared.frames.size(); ++i){
+        uint64_t frameIndex = mapped.table->unmap(base + i);
+        if (frameIndex != PageTable::NO_FRAME && releaseFrame(frameIndex))
+            ++freed;
+    }
+
+    if (--shared.attached == 0)
+        shared.frames.clear();
+
+    return freed;
+}
+
+bool PagingMemoryAllocator::translateSegment(Process* process, int segment, size_t offset, Translation &translation){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(process->getPID());
+    if (it == pageTables.end() || offset >= segmentFrames * FRAME_BYTES)
+        return false;
+
+    const std::vector<int> &attached = it->second.segments;
+    if (std::find(attached.begin(), attached.end(), segment) == attached.end())
+        return false;
+
+    PageTable::Translation mapping;
+    size_t virtualFrame = getSegmentBase(*it->second.table, segment) + offset / FRAME_BYTES;
+    if (!it->second.table->lookup(virtualFrame, mapping))
+        return false;
+
+    translation.physicalAddress = mapping.frame * FRAME_BYTES + offset % FRAME_BYTES;
+    translation.virtualFrame = virtualFrame;
+    translation.frame = mapping.frame;
+    translation.pageFrames = 1;
+    translation.walkLevels = mapping.levels;
+    return true;
+}
+
+void PagingMemoryAllocator::getSegmentInfo(size_t &segmentsInUse, size_t &attachments, size_t &frames){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    segmentsInUse = attachments = frames = 0;
+
+    for (const Segment &segment : segments){
+        if (segment.attached == 0)
+            continue;
+
+        ++segmentsInUse;
+        attachments += segment.attached;
+        frames += segment.frames.size();
+    }
+}
+
+size_t PagingMemoryAllocator::getVirtualFrame(size_t memPerPage, size_t address){
+    size_t pageBytes = memPerPage * FRAME_BYTES;
+    return (address / pageBytes) * setPageSize(memPerPage) + (address % pageBytes) / FRAME_BYTES;
+}
+
+bool PagingMemoryAllocator::getMappedFrames(Process* process, std::vector<uint64_t> &frames){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(process->getPID());
+    if (it == pageTables.end())
+        return false;
+
+    PageTable::Translation mapping;
+    frames.assign(it->second.virtualFrames, PageTable::NO_FRAME);
+    for (size_t virtualFrame = 0; virtualFrame < frames.size(); ++virtualFrame){
+        if (it->second.table->lookup(virtualFrame, mapping))
+            frames[virtualFrame] = mapping.frame;
+    }
+
+    return true;
+}
+
+// Called with allocationMutex held
+bool PagingMemoryAllocator::remapFrame(Process* process, size_t virtualFrame, size_t frame, bool &freed){
+    auto it = pageTables.find(process->getPID());
+    PageTable::Translation mapping;
+    if (it == pageTables.end() || !it->second.table->lookup(virtualFrame, mapping) || mapping.frame == frame)
+        return false;
+
+    it->second.table->map(virtualFrame, frame);
+    ++frameMap[frame];
+    freed = releaseFrame(mapping.frame);
+
+    // The process no longer holds a frame of its own there
+    if (freed){
+        size_t &active = activeMemMap[process->getPID()];
+        active -= std::min(active, FRAME_BYTES / 1024);
+    }
+
+    return true;
+}
+
+bool PagingMemoryAllocator::mergeFrame(Process* process, size_t virtualFrame, size_t frame, uint64_t stamp, bool &freed){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto merged = mergedFrames.find(frame);
+    if (merged == mergedFrames.end() || merged->second != stamp)
+        return false;
+
+    return remapFrame(process, virtualFrame, frame, freed);
+}
+
+uint64_t PagingMemoryAllocator::mergeFrame(Process* process, size_t virtualFrame, Process* owner, size_t ownerVirtualFrame, size_t &frame, bool &freed){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(owner->getPID());
+    PageTable::Translation mapping;
+    if (it == pageTables.end() || !it->second.table->lookup(ownerVirtualFrame, mapping))
+        return 0;
+
+    frame = mapping.frame;
+    if (!remapFrame(process, virtualFrame, frame, freed))
+        return 0;
+
+    uint64_t &stamp = mergedFrames[frame];
+    if (stamp == 0)
+        stamp = ++mergeStamp;
+
+    return stamp;
+}
+
+void PagingMemoryAllocator::getFrameSharing(size_t &shared, size_t &privateFrames, size_t &saved){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    shared = privateFrames = saved = 0;
+
+    for (const auto &pair : frameMap){
+        if (pair.second > 1){
+            ++shared;
+            saved += pair.second - 1;
+        }
+        else
+            ++privateFrames;
+    }
+}
+
+size_t PagingMemoryAllocator::getPrivateFrames(Process* process){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    auto it = pageTables.find(process->getPID());
+    if (it == pageTables.end())
+        return 0;
+
+    PageTable::Translation mapping;
+    size_t frames = 0;
+    for (size_t virtualFrame = 0; virtualFrame < it->second.virtualFrames; ++virtualFrame){
+        if (it->second.table->lookup(virtualFrame, mapping) && frameMap[mapping.frame] == 1)
+            ++frames;
+    }
+
+    return frames;
+}
+
+// Frames shared by page merging right now, and the frames that saves: every reference to one of
+// them but the first
+void PagingMemoryAllocator::getMergedSharing(size_t &frames, size_t &saved){
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    frames = mergedFrames.size();
+    saved = 0;
+
+    for (const auto &pair : mergedFrames){
+        auto references = frameMap.find(pair.first);
+        if (references != frameMap.end() && references->second > 1)
+            saved += references->second - 1;
+    }
 }
 
 size_t PagingMemoryAllocator::setPageSize(size_t memPerPage){
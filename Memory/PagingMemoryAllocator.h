@@ -15,22 +15,55 @@
 #include <mutex>
 
 #include "IMemoryAllocator.h"
+#include "PageTable.h"
 #include "../Processor/Process.h"
 #include "../UI/UI_Manager.h"
 
 class PagingMemoryAllocator : public IMemoryAllocator {
 public:
-    PagingMemoryAllocator(size_t maxSize);
+    PagingMemoryAllocator(size_t maxSize, int pageTableLevels, int pageTableBits, bool hugePages, int numSegments, size_t segmentFrames);
     ~PagingMemoryAllocator();
 
     void* allocate(Process* process) override;
     size_t deallocate(Process* process) override;
+    size_t grow(Process* process, size_t pages) override;
+    size_t shrink(Process* process, size_t pages) override;
+    bool translate(Process* process, size_t address, bool write, Translation &translation) override;
+    // Maps the child onto every frame of the parent, copy-on-write. Returns the child's handle,
+    // or null if the parent is not in memory.
+    void* fork(Process* parent, Process* child);
 
     size_t getMaxSize() const override;
     std::string getName() const override;
     size_t getTotalMemReqProc() const;
     size_t getActiveMem() const;
+    bool getPageTableInfo(Process* process, size_t &tables, size_t &bytes, size_t &hugePageCount);
+    void getPageTableTotals(size_t &bytes, size_t &flatBytes, size_t &hugePageCount);
+    // Frames mapped by more than one process and by exactly one, and the frames sharing saves
+    void getFrameSharing(size_t &shared, size_t &privateFrames, size_t &saved);
+    // Frames of a process's own address space that no other process maps
+    size_t getPrivateFrames(Process* process);
+    // Frames shared by page merging and the frames that saves, as of now
+    void getMergedSharing(size_t &frames, size_t &saved);
 
+    // Virtual frame a byte address of a process falls in
+    size_t getVirtualFrame(size_t memPerPage, size_t address);
+    // Physical frame behind each virtual frame of a process, PageTable::NO_FRAME where unmapped
+    bool getMappedFrames(Process* process, std::vector<uint64_t> &frames);
+    // Page merging points a process's virtual frame at a frame with the same contents: either one
+    // merged before, which is only still valid while it keeps its stamp, or the frame behind
+    // another process's virtual frame, which returns the stamp it gets (0 on failure). freed
+    // reports whether the process held the last reference to the frame it gave up.
+    bool mergeFrame(Process* process, size_t virtualFrame, size_t frame, uint64_t stamp, bool &freed);
+    uint64_t mergeFrame(Process* process, size_t virtualFrame, Process* owner, size_t ownerVirtualFrame, size_t &frame, bool &freed);
+
+    // Shared memory segments are mapped at the top of every address space that attaches them, one
+    // fixed slot per segment. A segment's frames are taken by its first attach (reported in
+    // allocated) and given back by its last detach, which returns the frames freed.
+    bool attachSegment(Process* process, int segment, size_t &allocated);
+    size_t detachSegment(Process* process, int segment);
+    bool translateSegment(Process* process, int segment, size_t offset, Translation &translation);
+    void getSegmentInfo(size_t &segmentsInUse, size_t &attachments, size_t &frames);
 
     void writeProcessToBackingStore(Process* ProcessIN, Process* ProcessOUT);
     void readProcessFromBackingStore(Process* process);
@@ -43,11 +76,40 @@ private:
     size_t activeMem;
     size_t totalMemReqProc;
     std::unordered_map<size_t, size_t> activeMemMap;
+    // Processes mapping each frame in use; more than one after a fork until a write copies it
     std::unordered_map<size_t, size_t> frameMap;
+    // Frames shared by page merging, with the stamp they got; dropped once only one process maps them
+    std::unordered_map<size_t, uint64_t> mergedFrames;
+    uint64_t mergeStamp;
+
+    struct MappedProcess{
+        std::unique_ptr<PageTable> table;
+        size_t virtualFrames;
+        std::vector<int> segments;
+    };
+
+    struct Segment{
+        std::vector<size_t> frames;
+        size_t attached = 0;
+    };
+
+    // Page table of each resident process
+    int pageTableLevels;
+    int pageTableBits;
+    bool hugePages;
+    std::unordered_map<size_t, MappedProcess> pageTables;
     std::vector<size_t> freeFrameList;
+    size_t segmentFrames;
+    std::vector<Segment> segments;
 
     size_t setPageSize(size_t memPerPage);
-    std::vector<size_t> allocateFrames(size_t numPages, size_t memPerPage, size_t processID);
+    std::vector<size_t> allocateFrames(size_t numPages, size_t memPerPage);
+    bool releaseFrame(size_t frame);
+    bool remapFrame(Process* process, size_t virtualFrame, size_t frame, bool &freed);
+    bool findFreeRun(size_t count, size_t &start) const;
+    size_t getAddressLimit(const PageTable &table) const;
+    size_t getSegmentBase(const PageTable &table, int segment) const;
+    size_t unmapSegment(MappedProcess &mapped, int segment);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include <algorithm>
+
+#include "ProcessHeap.h"
+
+std::atomic<size_t> ProcessHeap::totalPages(0);
+std::atomic<size_t> ProcessHeap::totalBytesInUse(0);
+std::atomic<uint64_t> ProcessHeap::totalFailures(0);
+
+ProcessHeap::ProcessHeap(uint64_t baseAddress, size_t pageBytes)
+    : baseAddress(baseAddress), pageBytes(pageBytes), bytesInUse(0), allocationCount(0){
+    // Classes go from MIN_BLOCK up to half a page, so every slab holds at least two blocks
+    numClasses = 0;
+    while (blockSize(numClasses) * 2 <= pageBytes)
+        ++numClasses;
+
+    partialPages.resize(numClasses);
+}
+
+ProcessHeap::ProcessHeap(const ProcessHeap &other)
+    : baseAddress(other.baseAddress), pageBytes(other.pageBytes), numClasses(other.numClasses), pages(other.pages),
+    partialPages(other.partialPages), freePages(other.freePages), bytesInUse(other.bytesInUse), allocationCount(other.allocationCount){
+    totalPages += pages.size();
+    totalBytesInUse += bytesInUse;
+}
+
+ProcessHeap::~ProcessHeap(){
+    totalPages -= pages.size();
+    totalBytesInUse -= bytesInUse;
+}
+
+uint64_t ProcessHeap::allocate(size_t bytes){
+    if (bytes == 0)
+        bytes = 1;
+
+    int sizeClass = sizeClassOf(bytes);
+
+    if (sizeClass >= 0){
+        uint32_t index;
+
+        if (!partialPages[sizeClass].empty())
+            index = *partialPages[sizeClass].begin();
+        else if (!freePages.empty()){
+            // Turn the lowest free page into a new slab for this class
+            index = *freePages.begin();
+            freePages.erase(freePages.begin());
+
+            HeapPage &page = pages[index];
+            uint32_t blocks = static_cast<uint32_t>(pageBytes / blockSize(sizeClass));
+            page.sizeClass = sizeClass;
+            page.used = 0;
+            page.freeBlocks.clear();
+            for (uint32_t block = blocks; block > 0; --block)
+                page.freeBlocks.push_back(block - 1);
+
+            partialPages[sizeClass].insert(index);
+        }
+        else
+            return 0;
+
+        HeapPage &page = pages[index];
+        uint32_t block = page.freeBlocks.back();
+        page.freeBlocks.pop_back();
+        ++page.used;
+
+        if (page.freeBlocks.empty())
+            partialPages[sizeClass].erase(index);
+
+        size_t size = blockSize(sizeClass);
+        bytesInUse += size;
+        totalBytesInUse += size;
+        ++allocationCount;
+
+        return baseAddress + index * pageBytes + block * size;
+    }
+
+    size_t runLength = (bytes + pageBytes - 1) / pageBytes;
+    size_t start = findFreeRun(runLength);
+    if (start == pages.size())
+        return 0;
+
+    for (size_t i = start; i < start + runLength; ++i){
+        pages[i].sizeClass = LARGE_PAGE;
+        pages[i].runLength = 0;
+        freePages.erase(static_cast<uint32_t>(i));
+    }
+    pages[start].runLength = static_cast<uint32_t>(runLength);
+
+    bytesInUse += runLength * pageBytes;
+    totalBytesInUse += runLength * pageBytes;
+    ++allocationCount;
+
+    return baseAddress + start * pageBytes;
+}
+
+size_t ProcessHeap::pagesNeeded(size_t bytes) const{
+    int sizeClass = sizeClassOf(bytes == 0 ? 1 : bytes);
+
+    if (sizeClass >= 0)
+        return (partialPages[sizeClass].empty() && freePages.empty()) ? 1 : 0;
+
+    size_t runLength = (bytes + pageBytes - 1) / pageBytes;
+    if (findFreeRun(runLength) != pages.size())
+        return 0;
+
+    // Free pages at the top of the heap count towards the run
+    size_t trailing = 0;
+    while (trailing < pages.size() && pages[pages.size() - 1 - trailing].sizeClass == FREE_PAGE)
+        ++trailing;
+
+    return runLength - std::min(runLength, trailing);
+}
+
+void ProcessHeap::grow(size_t count){
+    for (size_t i = 0; i < count; ++i){
+        freePages.insert(static_cast<uint32_t>(pages.size()));
+        pages.emplace_back();
+    }
+
+    totalPages += count;
+}
+
+size_t ProcessHeap::free(uint64_t address){
+    if (address < baseAddress || address >= baseAddress + pages.size() * pageBytes)
+        return 0;
+
+    uint32_t index = static_cast<uint32_t>((address - baseAddress) / pageBytes);
+    HeapPage &page = pages[index];
+
+    if (page.sizeClass >= 0){
+        size_t size = blockSize(page.sizeClass);
+        uint32_t block = static_cast<uint32_t>((address - baseAddress - index * pageBytes) / size);
+
+        page.freeBlocks.push_back(block);
+        --page.used;
+        bytesInUse -= size;
+        totalBytesInUse -= size;
+
+        // An empty slab goes back to being a free page any class can use
+        if (page.used == 0){
+            partialPages[page.sizeClass].erase(index);
+            page.sizeClass = FREE_PAGE;
+            page.freeBlocks.clear();
+            page.freeBlocks.shrink_to_fit();
+            freePages.insert(index);
+        }
+        else
+            partialPages[page.sizeClass].insert(index);
+    }
+    else if (page.sizeClass == LARGE_PAGE && page.runLength > 0){
+        size_t runLength = page.runLength;
+
+        for (size_t i = index; i < index + runLength; ++i){
+            pages[i].sizeClass = FREE_PAGE;
+            pages[i].runLength = 0;
+            freePages.insert(static_cast<uint32_t>(i));
+        }
+
+        bytesInUse -= runLength * pageBytes;
+        totalBytesInUse -= runLength * pageBytes;
+    }
+    else
+        return 0;
+
+    --allocationCount;
+    return trimTop();
+}
+
+size_t ProcessHeap::trimTop(){
+    size_t released = 0;
+
+    while (!pages.empty() && pages.back().sizeClass == FREE_PAGE){
+        freePages.erase(static_cast<uint32_t>(pages.size() - 1));
+        pages.pop_back();
+        ++released;
+    }
+
+    totalPages -= released;
+    return released;
+}
+
+int ProcessHeap::sizeClassOf(size_t bytes) const{
+    for (int sizeClass = 0; sizeClass < numClasses; ++sizeClass){
+        if (bytes <= blockSize(sizeClass))
+            return sizeClass;
+    }
+
+    return -1;
+}
+
+size_t ProcessHeap::blockSize(int sizeClass) const{
+    return MIN_BLOCK << sizeClass;
+}
+
+size_t ProcessHeap::findFreeRun(size_t count) const{
+    size_t run = 0;
+
+    for (size_t i = 0; i < pages.size(); ++i){
+        run = (pages[i].sizeClass == FREE_PAGE) ? run + 1 : 0;
+        if (run == count)
+            return i + 1 - count;
+    }
+
+    return pages.size();
+}
+
+size_t ProcessHeap::getPageCount() const{
+    return pages.size();
+}
+
+size_t ProcessHeap::getBytesInUse() const{
+    return bytesInUse;
+}
+
+size_t ProcessHeap::getAllocationCount() const{
+    return allocationCount;
+}
+
+size_t ProcessHeap::getTotalPages(){
+    return totalPages.load();
+}
+
+size_t ProcessHeap::getTotalBytesInUse(){
+    return totalBytesInUse.load();
+}
+
+uint64_t ProcessHeap::getTotalFailures(){
+    return totalFailures.load();
+}
+
+void ProcessHeap::recordFailure(){
+    ++totalFailures;
+}
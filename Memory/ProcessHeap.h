@@ -0,0 +1,71 @@
+#pragma once
+#ifndef PROCESS_HEAP_H
+#define PROCESS_HEAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <set>
+#include <atomic>
+
+// Heap of one process, laid out in whole pages right after the process's fixed memory. Small
+// requests are served from size-class slabs (one class per page, free blocks kept per page),
+// large ones from runs of pages. Like sbrk, the heap only hands pages back from its top.
+class ProcessHeap{
+public:
+    ProcessHeap(uint64_t baseAddress, size_t pageBytes);
+    // A forked process starts with a copy of its parent's heap
+    ProcessHeap(const ProcessHeap &other);
+    ~ProcessHeap();
+
+    // Returns the address of the block, or 0 if the heap has to grow first
+    uint64_t allocate(size_t bytes);
+    // Pages to add before allocate(bytes) can succeed
+    size_t pagesNeeded(size_t bytes) const;
+    void grow(size_t pages);
+
+    // Returns the number of pages released from the top of the heap
+    size_t free(uint64_t address);
+
+    size_t getPageCount() const;
+    size_t getBytesInUse() const;
+    size_t getAllocationCount() const;
+
+    // Totals over every heap, for vmstat
+    static size_t getTotalPages();
+    static size_t getTotalBytesInUse();
+    static uint64_t getTotalFailures();
+    static void recordFailure();
+
+private:
+    static constexpr size_t MIN_BLOCK = 16;
+    static constexpr int FREE_PAGE = -1;
+    static constexpr int LARGE_PAGE = -2;
+
+    struct HeapPage{
+        int sizeClass = FREE_PAGE;
+        uint32_t used = 0;
+        uint32_t runLength = 0;
+        std::vector<uint32_t> freeBlocks;
+    };
+
+    int sizeClassOf(size_t bytes) const;
+    size_t blockSize(int sizeClass) const;
+    size_t findFreeRun(size_t pages) const;
+    size_t trimTop();
+
+    uint64_t baseAddress;
+    size_t pageBytes;
+    int numClasses;
+    std::vector<HeapPage> pages;
+    std::vector<std::set<uint32_t>> partialPages;
+    std::set<uint32_t> freePages;
+    size_t bytesInUse;
+    size_t allocationCount;
+
+    static std::atomic<size_t> totalPages;
+    static std::atomic<size_t> totalBytesInUse;
+    static std::atomic<uint64_t> totalFailures;
+};
+
+#endif
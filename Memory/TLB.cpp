@@ -0,0 +1,87 @@
+#include <algorithm>
+
+#include "TLB.h"
+
+TLB::TLB(int entries, int ways) : clock(0), currentAsid(0), hasContext(false), hits(0), misses(0), flushes(0), flushedEntries(0){
+    this->ways = std::max(1, std::min(ways, entries));
+    numSets = std::max(1, entries / this->ways);
+    this->entries.resize(static_cast<size_t>(numSets) * this->ways);
+}
+
+bool TLB::lookup(int asid, uint64_t page, uint64_t frame){
+    // Mixing the ASID in keeps processes that use the same low pages from all landing in one set
+    uint64_t set = (page ^ (static_cast<uint64_t>(asid) * 0x9E3779B97F4A7C15ULL >> 40)) % numSets;
+    Entry* first = &entries[set * ways];
+    Entry* victim = first;
+    ++clock;
+
+    for (Entry* entry = first; entry < first + ways; ++entry){
+        if (entry->valid && entry->asid == asid && entry->page == page){
+            entry->lastUse = clock;
+            if (entry->frame == frame){
+                ++hits;
+                return true;
+            }
+
+            entry->frame = frame;
+            ++misses;
+            return false;
+        }
+
+        // Invalid entries go first, then the least recently used
+        if (victim->valid && (!entry->valid || entry->lastUse < victim->lastUse))
+            victim = entry;
+    }
+
+    victim->valid = true;
+    victim->asid = asid;
+    victim->page = page;
+    victim->frame = frame;
+    victim->lastUse = clock;
+    ++misses;
+    return false;
+}
+
+void TLB::switchTo(int asid, bool tagged){
+    if (!tagged && hasContext && asid != currentAsid)
+        flush();
+
+    currentAsid = asid;
+    hasContext = true;
+}
+
+void TLB::flush(){
+    uint64_t flushed = 0;
+    for (Entry &entry : entries){
+        if (entry.valid)
+            ++flushed;
+        entry.valid = false;
+    }
+
+    ++flushes;
+    flushedEntries += flushed;
+}
+
+int TLB::getEntries() const{
+    return static_cast<int>(entries.size());
+}
+
+int TLB::getWays() const{
+    return ways;
+}
+
+uint64_t TLB::getHits() const{
+    return hits;
+}
+
+uint64_t TLB::getMisses() const{
+    return misses;
+}
+
+uint64_t TLB::getFlushes() const{
+    return flushes;
+}
+
+uint64_t TLB::getFlushedEntries() const{
+    return flushedEntries;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef TLB_H
+#define TLB_H
+
+#include <cstdint>
+#include <vector>
+#include <atomic>
+
+// Translation lookaside buffer of one core: set-associative, LRU within a set. With ASIDs, entries
+// are tagged with the process's PID and survive context switches; without them the core flushes
+// its TLB whenever it switches to a different process. Only the owning core's worker touches the
+// entries, so only the statistics need to be atomic.
+class TLB{
+public:
+    // Set in the page number of a huge page's entry, so it never matches a base page
+    static constexpr uint64_t HUGE_PAGE = 1ULL << 62;
+
+    TLB(int entries, int ways);
+
+    // True on a hit. A miss, or a hit on an entry whose frame has changed since it was filled
+    // (the process was swapped out and back in), installs the current translation.
+    bool lookup(int asid, uint64_t page, uint64_t frame);
+    void switchTo(int asid, bool tagged);
+    void flush();
+
+    int getEntries() const;
+    int getWays() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    uint64_t getFlushes() const;
+    uint64_t getFlushedEntries() const;
+
+private:
+    struct Entry{
+        bool valid = false;
+        int asid = 0;
+        uint64_t page = 0;
+        uint64_t frame = 0;
+        uint64_t lastUse = 0;
+    };
+
+    int ways;
+    int numSets;
+    std::vector<Entry> entries;
+    uint64_t clock;
+    int currentAsid;
+    bool hasContext;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> flushes;
+    std::atomic<uint64_t> flushedEntries;
+};
+
+#endif
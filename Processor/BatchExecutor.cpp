@@ -0,0 +1,241 @@
+#include <cstring>
+#include <algorithm>
+
+#include "BatchExecutor.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BATCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define BATCH_SSE2
+#endif
+
+BatchExecutor::BatchExecutor(const std::vector<Process*> &processes) : vectorLines(0), scalarLines(0){
+    numLanes = std::min(static_cast<int>(processes.size()), MAX_LANES);
+    paddedLanes = (numLanes + 15) / 16 * 16;
+
+    std::memset(vars, 0, sizeof(vars));
+    std::memset(values, 0, sizeof(values));
+    std::memset(mask, 0, sizeof(mask));
+
+    // Gather each process's variables into its column
+    for (int lane = 0; lane < numLanes; ++lane){
+        Process* process = processes[lane];
+        lanes[lane] = process;
+        pcs[lane] = process->pc();
+        ends[lane] = process->numInstruction;
+        executed[lane] = 0;
+        stopped[lane] = false;
+
+        for (int var = 0; var < InstructionGenerator::NUM_VARIABLES; ++var)
+            vars[var][lane] = process->variables[var];
+    }
+}
+
+long long BatchExecutor::run(int lines){
+    long long total = 0;
+
+    for (int step = 0; step < lines; ++step){
+        decode();
+
+        int leader = -1;
+        for (int lane = 0; lane < numLanes && leader < 0; ++lane){
+            if (active[lane])
+                leader = lane;
+        }
+
+        if (leader < 0)
+            break;
+
+        ICommand::CommandType leaderType = static_cast<ICommand::CommandType>(types[leader]);
+        int leaderVar = varIndex[leader];
+        bool vectorizable = leaderType == ICommand::ADD || leaderType == ICommand::SUB || leaderType == ICommand::MUL;
+
+        // Lanes agreeing with the leader go through the SIMD kernel, the rest run one at a time
+        for (int lane = 0; lane < numLanes; ++lane){
+            bool matches = vectorizable && active[lane] && types[lane] == leaderType && varIndex[lane] == leaderVar;
+            mask[lane] = matches ? 0xFFFF : 0;
+
+            if (matches)
+                ++vectorLines;
+        }
+
+        if (vectorizable)
+            executeVector(leaderType, leaderVar);
+
+        for (int lane = 0; lane < numLanes; ++lane){
+            if (!active[lane])
+                continue;
+
+            if (!mask[lane]){
+                ++scalarLines;
+                if (!executeScalar(lane))
+                    continue;
+            }
+
+            ++pcs[lane];
+            ++executed[lane];
+            ++total;
+        }
+    }
+
+    return total;
+}
+
+void BatchExecutor::decode(){
+    int previous = -1;
+
+    for (int lane = 0; lane < numLanes; ++lane){
+        active[lane] = !stopped[lane] && pcs[lane] < ends[lane];
+        if (!active[lane])
+            continue;
+
+        Process* process = lanes[lane];
+
+        // Lanes sharing a program and a line share the opcode, so only the operand is generated again
+        if (previous >= 0 && lanes[previous]->programSeed == process->programSeed && pcs[previous] == pcs[lane]){
+            types[lane] = types[previous];
+            varIndex[lane] = varIndex[previous];
+            values[lane] = InstructionGenerator::generateValue(process->instructionSeed, pcs[lane]);
+        }
+        else{
+            Instruction instruction = InstructionGenerator::generate(process->programSeed, process->instructionSeed, pcs[lane]);
+            types[lane] = static_cast<uint8_t>(instruction.type);
+            varIndex[lane] = instruction.var;
+            values[lane] = instruction.value;
+        }
+
+        previous = lane;
+    }
+}
+
+void BatchExecutor::executeVector(ICommand::CommandType type, int var){
+    uint16_t* row = vars[var];
+
+#if defined(BATCH_AVX2)
+    for (int lane = 0; lane < paddedLanes; lane += 16){
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(&row[lane]));
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(&values[lane]));
+        __m256i m = _mm256_load_si256(reinterpret_cast<const __m256i*>(&mask[lane]));
+        __m256i r = (type == ICommand::ADD) ? _mm256_add_epi16(v, x) : (type == ICommand::SUB) ? _mm256_sub_epi16(v, x) : _mm256_mullo_epi16(v, x);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(&row[lane]), _mm256_blendv_epi8(v, r, m));
+    }
+#elif defined(BATCH_SSE2)
+    for (int lane = 0; lane < paddedLanes; lane += 8){
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(&row[lane]));
+        __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(&values[lane]));
+        __m128i m = _mm_load_si128(reinterpret_cast<const __m128i*>(&mask[lane]));
+        __m128i r = (type == ICommand::ADD) ? _mm_add_epi16(v, x) : (type == ICommand::SUB) ? _mm_sub_epi16(v, x) : _mm_mullo_epi16(v, x);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&row[lane]), _mm_or_si128(_mm_and_si128(m, r), _mm_andnot_si128(m, v)));
+    }
+#else
+    // Branch-free form so the compiler can vectorize it
+    for (int lane = 0; lane < paddedLanes; ++lane){
+        uint16_t r = (type == ICommand::ADD) ? static_cast<uint16_t>(row[lane] + values[lane])
+                   : (type == ICommand::SUB) ? static_cast<uint16_t>(row[lane] - values[lane])
+                   : static_cast<uint16_t>(static_cast<uint32_t>(row[lane]) * values[lane]);
+        row[lane] = static_cast<uint16_t>((r & mask[lane]) | (row[lane] & ~mask[lane]));
+    }
+#endif
+}
+
+bool BatchExecutor::executeScalar(int lane){
+    uint16_t& var = vars[varIndex[lane]][lane];
+    uint16_t value = values[lane];
+
+    switch (types[lane]) {
+        case ICommand::PRINT:
+            lanes[lane]->print(pcs[lane], 1);
+            break;
+        case ICommand::ADD:
+            var = static_cast<uint16_t>(var + value);
+            break;
+        case ICommand::SUB:
+            var = static_cast<uint16_t>(var - value);
+            break;
+        case ICommand::MUL:
+            var = static_cast<uint16_t>(static_cast<uint32_t>(var) * value);
+            break;
+        case ICommand::DIV:
+            var /= value;
+            break;
+        case ICommand::MOD:
+            var %= value;
+            break;
+        case ICommand::ALLOC:
+            lanes[lane]->heapAllocate(value);
+            break;
+        case ICommand::FREE:
+            lanes[lane]->heapFree(value);
+            break;
+        case ICommand::READ:
+            lanes[lane]->accessMemory(var, false);
+            break;
+        case ICommand::WRITE:
+            lanes[lane]->accessMemory(var, true);
+            break;
+        case ICommand::ATTACH:
+            lanes[lane]->attachSegment(value);
+            break;
+        case ICommand::DETACH:
+            lanes[lane]->detachSegment(value);
+            break;
+        default:
+            return interpret(lane);
+    }
+
+    return true;
+}
+
+// Runs the line on the process itself, with its variables synced in and out of the columns
+bool BatchExecutor::interpret(int lane){
+    Process* process = lanes[lane];
+
+    for (int var = 0; var < InstructionGenerator::NUM_VARIABLES; ++var)
+        process->variables[var] = vars[var][lane];
+    process->pc() = pcs[lane];
+
+    process->executeCurrentCommand();
+
+    for (int var = 0; var < InstructionGenerator::NUM_VARIABLES; ++var)
+        vars[var][lane] = process->variables[var];
+
+    // The scheduler has to act on these before the process can go on, so the lane stops here
+    if (process->sleepTicks > 0 || process->ioPending || process->forkPending || process->syncPending || process->channelWait >= 0)
+        stopped[lane] = true;
+
+    return process->channelWait < 0;
+}
+
+// Scatters the columns back into the processes and updates their program counters
+void BatchExecutor::writeBack(){
+    for (int lane = 0; lane < numLanes; ++lane){
+        Process* process = lanes[lane];
+
+        for (int var = 0; var < InstructionGenerator::NUM_VARIABLES; ++var)
+            process->variables[var] = vars[var][lane];
+
+        process->commandCounter += executed[lane];
+        executed[lane] = 0;
+
+        if (pcs[lane] >= ends[lane]){
+            process->pc() = ends[lane] - 1;
+            process->state() = Process::FINISHED;
+        }
+        else
+            process->pc() = pcs[lane];
+    }
+}
+
+long long BatchExecutor::getVectorLines() const{
+    return vectorLines;
+}
+
+long long BatchExecutor::getScalarLines() const{
+    return scalarLines;
+}
+
+int BatchExecutor::getStoppedLanes() const{
+    return static_cast<int>(std::count(stopped, stopped + numLanes, true));
+}
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef BATCH_EXECUTOR_H
+#define BATCH_EXECUTOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Process.h"
+
+// Advances a batch of processes in lockstep, one line per step. Variables are kept in
+// structure-of-arrays form (one row per variable, one column per process) so that lanes running
+// the same arithmetic opcode on the same variable are updated with SIMD instructions. Lines the
+// batch has no kernel for, such as SLEEP, IO or SEND, go through the process's own interpreter,
+// and a lane that is then left waiting on the scheduler stops until the batch is written back.
+class BatchExecutor{
+public:
+    static constexpr int MAX_LANES = 64;
+
+    BatchExecutor(const std::vector<Process*> &processes);
+
+    long long run(int lines);
+    void writeBack();
+
+    long long getVectorLines() const;
+    long long getScalarLines() const;
+    // Lanes stopped on a line that needs the scheduler, e.g. a SLEEP or a blocked RECV
+    int getStoppedLanes() const;
+
+private:
+    void decode();
+    void executeVector(ICommand::CommandType type, int var);
+    // False if the line has to run again, like a SEND or RECV that found its channel busy
+    bool executeScalar(int lane);
+    bool interpret(int lane);
+
+    int numLanes;
+    int paddedLanes;
+    Process* lanes[MAX_LANES];
+    int pcs[MAX_LANES];
+    int ends[MAX_LANES];
+    int executed[MAX_LANES];
+
+    alignas(32) uint16_t vars[InstructionGenerator::NUM_VARIABLES][MAX_LANES];
+    alignas(32) uint16_t values[MAX_LANES];
+    alignas(32) uint16_t mask[MAX_LANES];
+    uint8_t types[MAX_LANES];
+    uint8_t varIndex[MAX_LANES];
+    bool active[MAX_LANES];
+    bool stopped[MAX_LANES];
+
+    long long vectorLines;
+    long long scalarLines;
+};
+
+#endif
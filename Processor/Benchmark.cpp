@@ -0,0 +1,196 @@
+#include <iostream>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+#include "Benchmark.h"
+#include "Scheduler.h"
+#include "BatchExecutor.h"
+#include "../Console/BaseScreen.h"
+#include "../UI/UI_Manager.h"
+
+void Benchmark::run(const std::string &name){
+    if (name == "fusion")
+        instructionFusion(20000000);
+    else if (name == "batch")
+        batchExecution(BatchExecutor::MAX_LANES, 200000);
+    else if (name == "creation")
+        processCreation(100000);
+    else{
+        std::cout << "Unknown benchmark: " << name << std::endl;
+        printList();
+    }
+}
+
+void Benchmark::printList(){
+    std::cout << "Available benchmarks:" << std::endl;
+    std::cout << "  fusion    ->  Instructions/second with and without superinstruction fusion." << std::endl;
+    std::cout << "  batch     ->  Lockstep SIMD execution of processes sharing a program vs the scalar interpreter." << std::endl;
+    std::cout << "  creation  ->  Processes created per second, one at a time vs pooled bulk generation." << std::endl;
+}
+
+void Benchmark::instructionFusion(int numInstructions){
+    bool previousSetting = Process::isFusionEnabled();
+
+    // Same PID, so both runs execute the exact same generated program and memory accesses
+    std::shared_ptr<Process> plain = createProcess(-1, numInstructions);
+    std::shared_ptr<Process> fused = createProcess(-1, numInstructions);
+
+    long long plainDispatches = 0;
+    long long fusedDispatches = 0;
+
+    Process::setFusionEnabled(false);
+    double plainSeconds = runProcess(*plain, plainDispatches);
+
+    Process::setFusionEnabled(true);
+    double fusedSeconds = runProcess(*fused, fusedDispatches);
+
+    Process::setFusionEnabled(previousSetting);
+
+    bool sameResult = plain->pc() == fused->pc();
+    for (int i = 0; i < InstructionGenerator::NUM_VARIABLES; ++i)
+        sameResult = sameResult && plain->variables[i] == fused->variables[i];
+
+    double plainRate = numInstructions / plainSeconds;
+    double fusedRate = numInstructions / fusedSeconds;
+
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|       INSTRUCTION FUSION BENCHMARK     |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "      Instructions:           " << numInstructions << std::endl;
+    std::cout << "      Without Fusion:         " << static_cast<long long>(plainRate) << " ins/s" << std::endl;
+    std::cout << "      With Fusion:            " << static_cast<long long>(fusedRate) << " ins/s" << std::endl;
+    std::cout << "      Speedup:                " << fusedRate / plainRate << "x" << std::endl;
+    std::cout << "      Dispatches (plain):     " << plainDispatches << std::endl;
+    std::cout << "      Dispatches (fused):     " << fusedDispatches << std::endl;
+    std::cout << "      Same Final State:       " << (sameResult ? "Yes" : "No") << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
+
+void Benchmark::batchExecution(int numProcesses, int numInstructions){
+    bool previousSetting = Process::isFusionEnabled();
+    uint64_t programSeed = InstructionGenerator::templateSeed(0);
+
+    // Two identical sets of processes running one program template with their own operands
+    std::vector<std::shared_ptr<Process>> scalarSet;
+    std::vector<std::shared_ptr<Process>> batchSet;
+    std::vector<Process*> batchLanes;
+
+    for (int i = 0; i < numProcesses; ++i){
+        scalarSet.push_back(createProcess(-(i + 1), numInstructions));
+        scalarSet.back()->programSeed = programSeed;
+
+        batchSet.push_back(createProcess(-(i + 1), numInstructions));
+        batchSet.back()->programSeed = programSeed;
+        batchSet.back()->instructionSeed = scalarSet.back()->instructionSeed;
+        batchLanes.push_back(batchSet.back().get());
+    }
+
+    long long dispatches = 0;
+    Process::setFusionEnabled(false);
+    double scalarSeconds = 0;
+    for (auto &process : scalarSet)
+        scalarSeconds += runProcess(*process, dispatches);
+    Process::setFusionEnabled(previousSetting);
+
+    auto startTime = std::chrono::steady_clock::now();
+    BatchExecutor executor(batchLanes);
+    long long batchLines = executor.run(numInstructions);
+    executor.writeBack();
+    std::chrono::duration<double> batchSeconds = std::chrono::steady_clock::now() - startTime;
+
+    // A lane stopped for the scheduler ends on a different line, so it counts as a mismatch
+    bool sameResult = true;
+    for (int i = 0; i < numProcesses; ++i){
+        sameResult = sameResult && scalarSet[i]->pc() == batchSet[i]->pc();
+        for (int var = 0; var < InstructionGenerator::NUM_VARIABLES; ++var)
+            sameResult = sameResult && scalarSet[i]->variables[var] == batchSet[i]->variables[var];
+    }
+
+    double scalarRate = dispatches / scalarSeconds;
+    double batchRate = batchLines / batchSeconds.count();
+
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|       BATCHED EXECUTION BENCHMARK      |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "      Processes:              " << numProcesses << std::endl;
+    std::cout << "      Instructions Each:      " << numInstructions << std::endl;
+    std::cout << "      Scalar Interpreter:     " << static_cast<long long>(scalarRate) << " ins/s" << std::endl;
+    std::cout << "      Batched:                " << static_cast<long long>(batchRate) << " ins/s" << std::endl;
+    std::cout << "      Speedup:                " << batchRate / scalarRate << "x" << std::endl;
+    std::cout << "      Vector Lines:           " << executor.getVectorLines() << std::endl;
+    std::cout << "      Scalar Lines:           " << executor.getScalarLines() << std::endl;
+    std::cout << "      Stopped Lanes:          " << executor.getStoppedLanes() << std::endl;
+    std::cout << "      Same Final State:       " << (sameResult ? "Yes" : "No") << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
+
+void Benchmark::processCreation(int numProcesses){
+    Scheduler& scheduler = Scheduler::getInstance();
+    Process::RequirementFlags reqFlags = { true, 1, true, 512 };
+
+    // One at a time the way the batch generator used to: make_shared, a freshly formatted
+    // timestamp and a screen for every process
+    double individualSeconds;
+    {
+        std::vector<std::shared_ptr<Process>> processes;
+        std::vector<std::shared_ptr<BaseScreen>> screens;
+        auto startTime = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < numProcesses; ++i){
+            auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            std::stringstream timestamp;
+            timestamp << std::put_time(std::localtime(&now), "%m/%d/%Y, %I:%M:%S %p");
+            std::string name = "p_" + std::to_string(i);
+
+            processes.push_back(std::make_shared<Process>(i, name, reqFlags, timestamp.str(), scheduler.getMinInstructions(), scheduler.getMaxInstructions(),
+                                                          scheduler.getMinMem(), scheduler.getMaxMem(), scheduler.getMinPage(), scheduler.getMaxPage()));
+            screens.push_back(std::make_shared<BaseScreen>(processes.back(), name));
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        individualSeconds = elapsed.count();
+    }
+
+    // Bulk path used by scheduler-test; a first pass fills the pool so the timed pass measures
+    // the steady state where finished processes' storage is being recycled
+    scheduler.generateProcesses(numProcesses);
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<Process>> processes = scheduler.generateProcesses(numProcesses);
+    std::chrono::duration<double> bulkSeconds = std::chrono::steady_clock::now() - startTime;
+
+    double individualRate = numProcesses / individualSeconds;
+    double bulkRate = numProcesses / bulkSeconds.count();
+
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|      PROCESS CREATION BENCHMARK        |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "      Processes:              " << numProcesses << std::endl;
+    std::cout << "      One At A Time:          " << static_cast<long long>(individualRate) << " proc/s" << std::endl;
+    std::cout << "      Pooled Bulk:            " << static_cast<long long>(bulkRate) << " proc/s" << std::endl;
+    std::cout << "      Speedup:                " << bulkRate / individualRate << "x" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
+
+std::shared_ptr<Process> Benchmark::createProcess(int pid, int numInstructions){
+    Scheduler& scheduler = Scheduler::getInstance();
+    Process::RequirementFlags reqFlags = { true, 1, true, 512 };
+
+    return std::make_shared<Process>(pid, "benchmark", reqFlags, "", numInstructions, numInstructions,
+                                     scheduler.getMinMem(), scheduler.getMaxMem(), scheduler.getMinPage(), scheduler.getMaxPage());
+}
+
+// Runs the whole program without the per-instruction delay and returns the elapsed seconds
+double Benchmark::runProcess(Process &process, long long &dispatches){
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int i = process.pc(); i < process.numInstruction;){
+        process.pc() = i;
+        i += process.executeNextCommand();
+        ++dispatches;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    return elapsed.count();
+}
@@ -0,0 +1,24 @@
+#pragma once
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <memory>
+
+#include "Process.h"
+
+class Benchmark{
+public:
+    static void run(const std::string &name);
+    static void printList();
+
+    static void instructionFusion(int numInstructions);
+    static void batchExecution(int numProcesses, int numInstructions);
+    static void processCreation(int numProcesses);
+
+private:
+    static std::shared_ptr<Process> createProcess(int pid, int numInstructions);
+    static double runProcess(Process &process, long long &dispatches);
+};
+
+#endif
@@ -0,0 +1,237 @@
+#include <iostream>
+#include <algorithm>
+
+#include "ChannelTable.h"
+#include "Process.h"
+
+ChannelTable* ChannelTable::sharedInstance = nullptr;
+
+ChannelTable& ChannelTable::getInstance(){
+    if (!sharedInstance)
+        initialize();
+
+    return *sharedInstance;
+}
+
+void ChannelTable::initialize(){
+    if (!sharedInstance)
+        sharedInstance = new ChannelTable();
+}
+
+void ChannelTable::destroy(){
+    if (sharedInstance){
+        delete sharedInstance;
+        sharedInstance = nullptr;
+    }
+}
+
+ChannelTable::ChannelTable() : capacity(16), timeout(1000), startTime(std::chrono::steady_clock::now()), parked(0),
+    messagesSent(0), messagesReceived(0), messagesDropped(0), messagesRefused(0), senderBlocks(0), receiverBlocks(0), timeouts(0),
+    blockedMicroseconds(0){
+    configure(8, capacity);
+}
+
+// Only called while reading the config, before any process runs
+void ChannelTable::configure(int channels, int capacity){
+    this->capacity = std::max(1, capacity);
+    this->channels.clear();
+
+    for (int i = 0; i < std::max(1, channels); ++i){
+        this->channels.push_back(std::make_unique<Channel>());
+        this->channels.back()->ring.resize(this->capacity);
+    }
+}
+
+void ChannelTable::setTimeout(int milliseconds){
+    timeout = std::max(0, milliseconds);
+}
+
+int ChannelTable::getChannelCount() const{
+    return static_cast<int>(channels.size());
+}
+
+int ChannelTable::getCapacity() const{
+    return capacity;
+}
+
+int ChannelTable::getTimeout() const{
+    return timeout;
+}
+
+ChannelTable::Channel& ChannelTable::getChannel(uint16_t operand){
+    return *channels[operand % channels.size()];
+}
+
+// The first process to use an end keeps it until it finishes
+bool ChannelTable::bind(std::atomic<uint32_t> &end, uint32_t slot){
+    uint32_t expected = NONE;
+    return end.compare_exchange_strong(expected, slot) || expected == slot;
+}
+
+// The index stores and the waiting-slot loads on both sides are sequentially consistent, so either
+// the side that parks sees the other side's progress or the other side sees the parked slot
+bool ChannelTable::send(Process* process, uint16_t operand, uint16_t value, bool block){
+    Channel& channel = getChannel(operand);
+    uint32_t slot = process->getSlot();
+
+    // Another process owns the sending end
+    if (!bind(channel.sender, slot)){
+        ++messagesRefused;
+        return true;
+    }
+
+    uint64_t tail = channel.tail.load(std::memory_order_relaxed);
+    if (tail - channel.head.load() < channel.ring.size()){
+        channel.ring[tail % channel.ring.size()] = value;
+        channel.tail.store(tail + 1);
+        ++messagesSent;
+        wake(channel.waitingReceiver, channel.receiverParkedAt);
+        return true;
+    }
+
+    // Full: wait for a receiver that can drain it, or drop the message if there is none
+    uint32_t receiver = channel.receiver.load();
+    if (block && receiver != NONE && receiver != slot)
+        return false;
+
+    ++messagesDropped;
+    return true;
+}
+
+bool ChannelTable::receive(Process* process, uint16_t operand, uint16_t &value, bool block){
+    Channel& channel = getChannel(operand);
+    uint32_t slot = process->getSlot();
+
+    // Another process owns the receiving end; the variable is left as it is
+    if (!bind(channel.receiver, slot)){
+        ++messagesRefused;
+        return true;
+    }
+
+    uint64_t head = channel.head.load(std::memory_order_relaxed);
+    if (channel.tail.load() != head){
+        value = channel.ring[head % channel.ring.size()];
+        channel.head.store(head + 1);
+        ++messagesReceived;
+        wake(channel.waitingSender, channel.senderParkedAt);
+        return true;
+    }
+
+    uint32_t sender = channel.sender.load();
+    return !(block && sender != NONE && sender != slot);
+}
+
+bool ChannelTable::park(uint32_t slot, uint16_t operand, bool sending){
+    Channel& channel = getChannel(operand);
+    std::atomic<uint32_t> &waiting = sending ? channel.waitingSender : channel.waitingReceiver;
+    (sending ? channel.senderParkedAt : channel.receiverParkedAt).store(currentMicroseconds());
+    waiting.store(slot);
+
+    // The other end may have moved, or finished, between the failed attempt and here
+    uint64_t head = channel.head.load();
+    uint64_t tail = channel.tail.load();
+    bool ready = sending ? tail - head < channel.ring.size() : tail != head;
+    uint32_t other = (sending ? channel.receiver : channel.sender).load();
+
+    // If the slot is already gone, the other end took it and the process is in pending
+    if ((ready || other == NONE) && waiting.exchange(NONE) == slot)
+        return false;
+
+    ++(sending ? senderBlocks : receiverBlocks);
+    ++parked;
+    return true;
+}
+
+// Whoever takes the waiting slot first owns the wakeup
+bool ChannelTable::wake(std::atomic<uint32_t> &waiting, std::atomic<uint64_t> &parkedAt){
+    if (waiting.load() == NONE)
+        return false;
+
+    uint32_t slot = waiting.exchange(NONE);
+    if (slot == NONE)
+        return false;
+
+    blockedMicroseconds += currentMicroseconds() - parkedAt.load();
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pending.push_back(slot);
+    return true;
+}
+
+void ChannelTable::advance(std::vector<uint32_t> &woken){
+    if (parked == 0)
+        return;
+
+    // Waits that ran past channel-timeout are ended as if the other end had moved
+    if (timeout > 0){
+        uint64_t now = currentMicroseconds();
+        uint64_t limit = static_cast<uint64_t>(timeout) * 1000;
+
+        for (const auto &channel : channels){
+            for (bool sending : { true, false }){
+                std::atomic<uint32_t> &waiting = sending ? channel->waitingSender : channel->waitingReceiver;
+                std::atomic<uint64_t> &parkedAt = sending ? channel->senderParkedAt : channel->receiverParkedAt;
+
+                if (waiting.load() != NONE && now - parkedAt.load() >= limit && wake(waiting, parkedAt))
+                    ++timeouts;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    woken.insert(woken.end(), pending.begin(), pending.end());
+    parked -= pending.size();
+    pending.clear();
+}
+
+void ChannelTable::release(uint32_t slot){
+    for (const auto &channel : channels){
+        uint32_t expected = slot;
+        if (channel->sender.compare_exchange_strong(expected, NONE))
+            wake(channel->waitingReceiver, channel->receiverParkedAt);
+
+        expected = slot;
+        if (channel->receiver.compare_exchange_strong(expected, NONE))
+            wake(channel->waitingSender, channel->senderParkedAt);
+    }
+}
+
+size_t ChannelTable::getParkedProcesses() const{
+    return parked;
+}
+
+uint64_t ChannelTable::currentMicroseconds() const{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void ChannelTable::printStatistics() const{
+    double seconds = currentMicroseconds() / 1000000.0;
+    uint64_t blocks = senderBlocks + receiverBlocks;
+    size_t bound = 0;
+    size_t queued = 0;
+
+    for (const auto &channel : channels){
+        if (channel->sender != NONE || channel->receiver != NONE)
+            ++bound;
+        queued += channel->tail - channel->head;
+    }
+
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|              IPC STATISTICS            |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << " Channels: " << channels.size() << " x " << capacity << " messages (timeout " << timeout << " ms)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "      Channels In Use:        " << bound << std::endl;
+    std::cout << "      Messages Queued:        " << queued << std::endl;
+    std::cout << "      Messages Sent:          " << messagesSent << std::endl;
+    std::cout << "      Messages Received:      " << messagesReceived << std::endl;
+    std::cout << "      Messages Dropped:       " << messagesDropped << " (channel full)" << std::endl;
+    std::cout << "      Refused (Not An End):   " << messagesRefused << std::endl;
+    std::cout << "      Throughput:             " << (seconds > 0 ? messagesReceived / seconds : 0.0) << " msgs/s" << std::endl;
+    std::cout << "      Sender Blocks:          " << senderBlocks << std::endl;
+    std::cout << "      Receiver Blocks:        " << receiverBlocks << std::endl;
+    std::cout << "      Avg Blocked Time:       " << (blocks > 0 ? blockedMicroseconds / 1000.0 / blocks : 0.0) << " ms" << std::endl;
+    std::cout << "      Timed Out Waits:        " << timeouts << std::endl;
+    std::cout << "      Parked Processes:       " << parked << std::endl;
+    std::cout << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#ifndef CHANNEL_TABLE_H
+#define CHANNEL_TABLE_H
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+class Process;
+
+// Bounded message channels for SEND and RECV. Each channel is a single-producer single-consumer
+// ring: its first sender and first receiver become its two ends, and each side only moves its own
+// index, so messages pass between cores without a lock. A SEND to a full channel or a RECV from an
+// empty one parks the process off-core until the other end makes room or delivers, the other end
+// finishes, or channel-timeout runs out; the instruction is then retried once without blocking.
+class ChannelTable{
+public:
+    static ChannelTable& getInstance();
+    static void initialize();
+    static void destroy();
+
+    void configure(int channels, int capacity);
+    void setTimeout(int milliseconds);
+    int getChannelCount() const;
+    int getCapacity() const;
+    int getTimeout() const;
+
+    // Run on the sending or receiving process's core. False when the process has to wait, which
+    // is only asked for when block is set.
+    bool send(Process* process, uint16_t operand, uint16_t value, bool block);
+    bool receive(Process* process, uint16_t operand, uint16_t &value, bool block);
+
+    // Called with the scheduler's queueMutex held. park() is false if the channel became ready
+    // while the process was yielding, in which case it goes straight back to the ready queue.
+    bool park(uint32_t slot, uint16_t operand, bool sending);
+    void advance(std::vector<uint32_t> &woken);
+    // Unbinds a finished process from its channels and wakes whoever waits on the other end
+    void release(uint32_t slot);
+    size_t getParkedProcesses() const;
+
+    void printStatistics() const;
+
+private:
+    ChannelTable();
+    ChannelTable(const ChannelTable&) = delete;
+    ChannelTable& operator=(const ChannelTable&) = delete;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Channel{
+        std::vector<uint16_t> ring;
+        // Written only by the receiver and the sender respectively, on separate cache lines
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+        alignas(64) std::atomic<uint32_t> sender{NONE};
+        std::atomic<uint32_t> receiver{NONE};
+        std::atomic<uint32_t> waitingSender{NONE};
+        std::atomic<uint32_t> waitingReceiver{NONE};
+        std::atomic<uint64_t> senderParkedAt{0};
+        std::atomic<uint64_t> receiverParkedAt{0};
+    };
+
+    Channel& getChannel(uint16_t operand);
+    bool bind(std::atomic<uint32_t> &end, uint32_t slot);
+    bool wake(std::atomic<uint32_t> &waiting, std::atomic<uint64_t> &parkedAt);
+    uint64_t currentMicroseconds() const;
+
+    std::vector<std::unique_ptr<Channel>> channels;
+    int capacity;
+    int timeout;
+    std::chrono::steady_clock::time_point startTime;
+
+    // Processes whose wait ended, handed to the scheduler by advance()
+    mutable std::mutex pendingMutex;
+    std::vector<uint32_t> pending;
+    std::atomic<size_t> parked;
+
+    std::atomic<uint64_t> messagesSent;
+    std::atomic<uint64_t> messagesReceived;
+    std::atomic<uint64_t> messagesDropped;
+    // SENDs and RECVs from processes that are not the channel's bound sender or receiver
+    std::atomic<uint64_t> messagesRefused;
+    std::atomic<uint64_t> senderBlocks;
+    std::atomic<uint64_t> receiverBlocks;
+    std::atomic<uint64_t> timeouts;
+    std::atomic<uint64_t> blockedMicroseconds;
+
+    static ChannelTable* sharedInstance;
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include "CpuBandwidth.h"
+#include "FastRandom.h"
+
+CpuBandwidth::CpuBandwidth() : shareMode(NONE), globalPass(0) {
+    defineGroup("batch", 0, 100, 100);
+    defineGroup("interactive", 0, 100, 100);
+}
+
+void CpuBandwidth::defineGroup(const std::string &name, int quota, int period, int weight){
+    int group = findGroup(name);
+    if (group < 0){
+        groups.emplace_back();
+        groups.back().name = name;
+        group = static_cast<int>(groups.size()) - 1;
+    }
+
+    groups[group].quota = std::max(0, quota);
+    groups[group].period = std::max(1, period);
+    groups[group].weight = std::max(1, weight);
+}
+
+int CpuBandwidth::findGroup(const std::string &name) const{
+    for (size_t group = 0; group < groups.size(); ++group){
+        if (groups[group].name == name)
+            return static_cast<int>(group);
+    }
+
+    return -1;
+}
+
+int CpuBandwidth::getGroupCount() const{
+    return static_cast<int>(groups.size());
+}
+
+bool CpuBandwidth::setShareMode(const std::string &mode){
+    if (mode == "off")
+        shareMode = NONE;
+    else if (mode == "stride")
+        shareMode = STRIDE;
+    else if (mode == "lottery")
+        shareMode = LOTTERY;
+    else
+        return false;
+
+    return true;
+}
+
+CpuBandwidth::ShareMode CpuBandwidth::getShareMode() const{
+    return shareMode;
+}
+
+std::string CpuBandwidth::getShareModeName() const{
+    return shareMode == STRIDE ? "stride" : shareMode == LOTTERY ? "lottery" : "off";
+}
+
+void CpuBandwidth::advance(uint64_t now){
+    for (Group &group : groups){
+        uint64_t length = static_cast<uint64_t>(group.period) * 1000;
+        if (now < group.periodStart + length)
+            continue;
+
+        uint64_t quota = static_cast<uint64_t>(group.quota) * 1000;
+        group.periodStart = now - (now - group.periodStart) % length;
+        group.used = group.used > quota ? group.used - quota : 0;
+
+        if (group.throttled && (group.quota == 0 || group.used < quota)){
+            group.throttledMicroseconds += now - group.throttledAt;
+            group.throttled = false;
+        }
+    }
+}
+
+bool CpuBandwidth::isThrottled(int group) const{
+    return groups[group].throttled;
+}
+
+void CpuBandwidth::charge(int group, uint64_t microseconds, uint64_t now){
+    Group &charged = groups[group];
+    charged.cpuMicroseconds += microseconds;
+
+    if (charged.quota == 0)
+        return;
+
+    charged.used += microseconds;
+    if (!charged.throttled && charged.used >= static_cast<uint64_t>(charged.quota) * 1000){
+        charged.throttled = true;
+        charged.throttledAt = now;
+        ++charged.throttles;
+    }
+}
+
+int CpuBandwidth::selectGroup(const std::vector<bool> &ready){
+    int selected = -1;
+
+    if (shareMode == STRIDE){
+        for (size_t group = 0; group < groups.size(); ++group){
+            if (!ready[group] || groups[group].throttled)
+                continue;
+
+            groups[group].pass = std::max(groups[group].pass, globalPass);
+            if (selected < 0 || groups[group].pass < groups[selected].pass)
+                selected = static_cast<int>(group);
+        }
+
+        if (selected >= 0){
+            globalPass = groups[selected].pass;
+            groups[selected].pass += STRIDE_ONE / groups[selected].weight;
+        }
+    }
+    else if (shareMode == LOTTERY){
+        int tickets = 0;
+        for (size_t group = 0; group < groups.size(); ++group){
+            if (ready[group] && !groups[group].throttled)
+                tickets += groups[group].weight;
+        }
+
+        if (tickets == 0)
+            return -1;
+
+        int draw = FastRandom::local().nextInt(0, tickets - 1);
+        for (size_t group = 0; group < groups.size() && selected < 0; ++group){
+            if (!ready[group] || groups[group].throttled)
+                continue;
+
+            draw -= groups[group].weight;
+            if (draw < 0)
+                selected = static_cast<int>(group);
+        }
+    }
+
+    return selected;
+}
+
+void CpuBandwidth::recordDispatch(int group){
+    ++groups[group].dispatches;
+}
+
+std::vector<CpuBandwidth::GroupUsage> CpuBandwidth::getGroupUsage(uint64_t now) const{
+    std::vector<GroupUsage> usage;
+
+    for (const Group &group : groups){
+        // A throttle still in effect counts up to now
+        uint64_t throttled = group.throttledMicroseconds + (group.throttled ? now - group.throttledAt : 0);
+        usage.push_back({ group.name, group.quota, group.period, group.weight, group.cpuMicroseconds, throttled,
+                          group.throttles, group.dispatches, group.throttled });
+    }
+
+    return usage;
+}
+
+void CpuBandwidth::printStatistics(uint64_t now) const{
+    uint64_t total = 0;
+    for (const Group &group : groups)
+        total += group.cpuMicroseconds;
+
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|            CPU BANDWIDTH               |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << " Share Mode: " << getShareModeName() << std::endl;
+    std::cout << std::endl;
+    std::cout << "   Group          Quota/Period (ms)   Weight   CPU Ticks   Share   Dispatches   Throttled (ms)   Throttles" << std::endl;
+
+    for (const GroupUsage &group : getGroupUsage(now)){
+        std::string bandwidth = group.quota > 0 ? std::to_string(group.quota) + "/" + std::to_string(group.period) : "none";
+        double share = total > 0 ? 100.0 * group.cpuMicroseconds / total : 0.0;
+
+        std::cout << "   " << std::left << std::setw(15) << group.name + (group.throttled ? "*" : "") << std::right
+                  << std::setw(17) << bandwidth << std::setw(11) << group.weight << std::setw(12) << group.cpuMicroseconds / 1000
+                  << std::fixed << std::setprecision(1) << std::setw(7) << share << "%" << std::setw(13) << group.dispatches
+                  << std::setw(17) << group.throttledMicroseconds / 1000 << std::setw(12) << group.throttles << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+
+    std::cout << std::endl;
+    std::cout << " * throttled until its period rolls over. One CPU tick is a millisecond of core time." << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef CPU_BANDWIDTH_H
+#define CPU_BANDWIDTH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CPU groups. A group with a quota may use that many milliseconds of core time per period, summed
+// over all cores; once it has, its ready processes are passed over until the period rolls over.
+// The check happens at dispatch, so a process already on a core finishes its quantum and the
+// overrun is carried into the next period. With a share mode set, each dispatch first picks a
+// group in proportion to the group weights, by stride or by lottery, and then the group's next
+// process. Groups are defined with 'cpu-group <name> <quota ms> <period ms> <weight>', a quota of 0
+// leaving the group unthrottled. The scheduler owns it and calls it under queueMutex.
+class CpuBandwidth{
+public:
+    enum ShareMode
+    {
+        NONE,
+        STRIDE,
+        LOTTERY
+    };
+
+    static constexpr int BATCH_GROUP = 0;
+    static constexpr int INTERACTIVE_GROUP = 1;
+
+    struct GroupUsage{
+        std::string name;
+        int quota;
+        int period;
+        int weight;
+        uint64_t cpuMicroseconds;
+        uint64_t throttledMicroseconds;
+        uint64_t throttles;
+        uint64_t dispatches;
+        bool throttled;
+    };
+
+    CpuBandwidth();
+
+    void defineGroup(const std::string &name, int quota, int period, int weight);
+    // -1 if there is no such group
+    int findGroup(const std::string &name) const;
+    int getGroupCount() const;
+    bool setShareMode(const std::string &mode);
+    ShareMode getShareMode() const;
+    std::string getShareModeName() const;
+
+    // Starts a new period for every group whose period has run out
+    void advance(uint64_t now);
+    bool isThrottled(int group) const;
+    // Core time a process of the group just used, throttling the group once its quota is spent
+    void charge(int group, uint64_t microseconds, uint64_t now);
+    // Picks the group to dispatch from among the unthrottled groups marked ready
+    int selectGroup(const std::vector<bool> &ready);
+    void recordDispatch(int group);
+
+    std::vector<GroupUsage> getGroupUsage(uint64_t now) const;
+    void printStatistics(uint64_t now) const;
+
+private:
+    // Pass added per dispatch is STRIDE_ONE / weight
+    static constexpr uint64_t STRIDE_ONE = 1 << 20;
+
+    struct Group{
+        std::string name;
+        int quota = 0;
+        int period = 100;
+        int weight = 100;
+        uint64_t periodStart = 0;
+        uint64_t used = 0;
+        bool throttled = false;
+        uint64_t throttledAt = 0;
+        uint64_t pass = 0;
+
+        uint64_t cpuMicroseconds = 0;
+        uint64_t throttledMicroseconds = 0;
+        uint64_t throttles = 0;
+        uint64_t dispatches = 0;
+    };
+
+    std::vector<Group> groups;
+    ShareMode shareMode;
+    // Pass of the last group picked; a group coming back from idle starts here, so it cannot
+    // make up for the time it had nothing to run
+    uint64_t globalPass;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include <random>
+
+#include "FastRandom.h"
+
+std::atomic<uint64_t> FastRandom::baseSeed(0);
+std::atomic<uint64_t> FastRandom::threadCounter(0);
+
+FastRandom::FastRandom(uint64_t seed){
+    for (int i = 0; i < 4; ++i)
+        state[i] = splitmix(seed);
+}
+
+uint64_t FastRandom::next(){
+    uint64_t result = rotl(state[1] * 5, 7) * 9;
+    uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+}
+
+// Uniform in [min, max] using the multiply-shift range reduction
+int FastRandom::nextInt(int min, int max){
+    if (max <= min)
+        return min;
+
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    uint64_t scaled = (next() >> 32) * range >> 32;
+
+    return static_cast<int>(min + static_cast<int64_t>(scaled));
+}
+
+void FastRandom::setSeed(uint64_t seed){
+    if (seed == 0){
+        std::random_device rd;
+        seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+
+    baseSeed.store(seed);
+}
+
+uint64_t FastRandom::getSeed(){
+    if (baseSeed.load() == 0)
+        setSeed(0);
+
+    return baseSeed.load();
+}
+
+uint64_t FastRandom::streamSeed(uint64_t key){
+    uint64_t x = getSeed() ^ (key * 0x9E3779B97F4A7C15ULL);
+    return splitmix(x);
+}
+
+FastRandom& FastRandom::local(){
+    thread_local FastRandom generator(streamSeed(0xFFFF000000000000ULL + threadCounter.fetch_add(1)));
+    return generator;
+}
+
+uint64_t FastRandom::splitmix(uint64_t &x){
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t FastRandom::rotl(uint64_t x, int k){
+    return (x << k) | (x >> (64 - k));
+}
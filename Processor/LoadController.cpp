@@ -0,0 +1,114 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include "LoadController.h"
+
+LoadController::LoadController() : enabled(false), interval(500), suspendRate(200), resumeRate(50), minActive(1),
+    lastSample(0), lastFaults(0), faultRate(0), suspensions(0), resumptions(0) {}
+
+void LoadController::setEnabled(bool enabled){
+    this->enabled = enabled;
+}
+
+bool LoadController::isEnabled() const{
+    return enabled;
+}
+
+void LoadController::setInterval(int milliseconds){
+    interval = std::max(1, milliseconds);
+}
+
+int LoadController::getInterval() const{
+    return interval;
+}
+
+void LoadController::setSuspendRate(double faultsPerSecond){
+    suspendRate = faultsPerSecond;
+}
+
+double LoadController::getSuspendRate() const{
+    return suspendRate;
+}
+
+void LoadController::setResumeRate(double faultsPerSecond){
+    resumeRate = faultsPerSecond;
+}
+
+double LoadController::getResumeRate() const{
+    return resumeRate;
+}
+
+void LoadController::setMinActive(int processes){
+    minActive = std::max(1, processes);
+}
+
+int LoadController::getMinActive() const{
+    return minActive;
+}
+
+bool LoadController::isDue(uint64_t now) const{
+    return now >= lastSample + interval;
+}
+
+// One process is suspended or resumed per interval, so the level moves gradually and the fault
+// rate has an interval to respond before the next step
+LoadController::Action LoadController::sample(uint64_t now, uint64_t pageFaults, size_t workingSetKB, size_t memoryKB,
+                                              size_t active, size_t suspended, size_t resumeKB){
+    faultRate = now > lastSample ? (pageFaults - lastFaults) * 1000.0 / (now - lastSample) : 0.0;
+    lastSample = now;
+    lastFaults = pageFaults;
+
+    Action action = NONE;
+    if (faultRate >= suspendRate && active > static_cast<size_t>(minActive))
+        action = SUSPEND;
+    else if (suspended > 0 && faultRate <= resumeRate && workingSetKB + resumeKB <= memoryKB)
+        action = RESUME;
+
+    if (action == SUSPEND)
+        ++suspensions;
+    else if (action == RESUME)
+        ++resumptions;
+
+    history.push_back({ now, faultRate, active, suspended, workingSetKB, action });
+    if (history.size() > HISTORY_SAMPLES)
+        history.pop_front();
+
+    return action;
+}
+
+double LoadController::getFaultRate() const{
+    return faultRate;
+}
+
+uint64_t LoadController::getSuspensions() const{
+    return suspensions;
+}
+
+uint64_t LoadController::getResumptions() const{
+    return resumptions;
+}
+
+void LoadController::printHistory() const{
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|             LOAD CONTROL               |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << " Load Control: " << (enabled ? "On" : "Off") << ", every " << interval << " ms, suspend at "
+              << suspendRate << " faults/s, resume at " << resumeRate << " faults/s" << std::endl;
+    std::cout << " Suspensions: " << suspensions << ", Resumptions: " << resumptions << std::endl;
+    std::cout << std::endl;
+    std::cout << "   Time (s)   Faults/s   Active   Suspended   Working Set (KB)   Action" << std::endl;
+
+    for (const Sample &sample : history){
+        const char* action = sample.action == SUSPEND ? "suspend" : sample.action == RESUME ? "resume" : "";
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(11) << sample.time / 1000.0 << std::setw(11) << sample.faultRate
+                  << std::setw(9) << sample.active << std::setw(12) << sample.suspended
+                  << std::setw(19) << sample.workingSetKB << "   " << action << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+
+    std::cout << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#ifndef LOAD_CONTROLLER_H
+#define LOAD_CONTROLLER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+
+// Page-fault-frequency load control. Once per interval the scheduler hands over the fault count
+// and the working sets it sampled; while faults come faster than the suspend rate the controller
+// asks for a process to be suspended, lowering the multiprogramming level, and once they drop to
+// the resume rate it lets suspended processes back in as long as their working sets fit in memory.
+// Enabled with the 'load-control' config key; the scheduler owns it and calls it under queueMutex.
+class LoadController{
+public:
+    enum Action
+    {
+        NONE,
+        SUSPEND,
+        RESUME
+    };
+
+    LoadController();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    void setInterval(int milliseconds);
+    int getInterval() const;
+    // Page faults per second
+    void setSuspendRate(double faultsPerSecond);
+    double getSuspendRate() const;
+    void setResumeRate(double faultsPerSecond);
+    double getResumeRate() const;
+    // Never suspend below this many active processes
+    void setMinActive(int processes);
+    int getMinActive() const;
+
+    bool isDue(uint64_t now) const;
+    // resumeKB is the working set of the process that would be resumed next
+    Action sample(uint64_t now, uint64_t pageFaults, size_t workingSetKB, size_t memoryKB,
+                  size_t active, size_t suspended, size_t resumeKB);
+
+    double getFaultRate() const;
+    uint64_t getSuspensions() const;
+    uint64_t getResumptions() const;
+    void printHistory() const;
+
+private:
+    static constexpr size_t HISTORY_SAMPLES = 40;
+
+    struct Sample{
+        uint64_t time;
+        double faultRate;
+        size_t active;
+        size_t suspended;
+        size_t workingSetKB;
+        Action action;
+    };
+
+    bool enabled;
+    int interval;
+    double suspendRate;
+    double resumeRate;
+    int minActive;
+
+    uint64_t lastSample;
+    uint64_t lastFaults;
+    double faultRate;
+    uint64_t suspensions;
+    uint64_t resumptions;
+    std::deque<Sample> history;
+};
+
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <new>
+
+// Pool of equally sized blocks carved out of large arenas. Freed blocks go on a free list and
+// are handed out again before the arena grows, so objects created and destroyed at a high rate
+// (processes, their screens) recycle each other's storage instead of going through malloc.
+template <size_t BlockSize>
+class BlockPool{
+public:
+    static BlockPool& getInstance(){
+        static BlockPool instance;
+        return instance;
+    }
+
+    void* allocate(){
+        std::lock_guard<std::mutex> lock(poolMutex);
+
+        if (freeList){
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            ++recycled;
+            ++inUse;
+            return block;
+        }
+
+        if (arenaUsed == BLOCKS_PER_ARENA){
+            arenas.push_back(static_cast<char*>(::operator new(BLOCKS_PER_ARENA * ALIGNED_SIZE)));
+            arenaUsed = 0;
+        }
+
+        void* block = arenas.back() + arenaUsed * ALIGNED_SIZE;
+        ++arenaUsed;
+        ++inUse;
+        return block;
+    }
+
+    void deallocate(void* pointer){
+        std::lock_guard<std::mutex> lock(poolMutex);
+
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = freeList;
+        freeList = block;
+        --inUse;
+    }
+
+    size_t getInUse() const { return inUse; }
+    size_t getRecycled() const { return recycled; }
+    size_t getArenaCount() const { return arenas.size(); }
+
+private:
+    static constexpr size_t ALIGNED_SIZE = (BlockSize + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    static constexpr size_t BLOCKS_PER_ARENA = 1024;
+
+    struct FreeBlock{
+        FreeBlock* next;
+    };
+
+    BlockPool() : freeList(nullptr), arenaUsed(BLOCKS_PER_ARENA), inUse(0), recycled(0) {}
+    ~BlockPool(){
+        for (char* arena : arenas)
+            ::operator delete(arena);
+    }
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    std::vector<char*> arenas;
+    FreeBlock* freeList;
+    size_t arenaUsed;
+    size_t inUse;
+    size_t recycled;
+    std::mutex poolMutex;
+};
+
+// Standard allocator over BlockPool, meant for std::allocate_shared so the object and its control
+// block share one pooled block.
+template <typename T>
+class PoolAllocator{
+public:
+    typedef T value_type;
+
+    PoolAllocator() = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n){
+        if (n != 1)
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+
+        return static_cast<T*>(BlockPool<sizeof(T)>::getInstance().allocate());
+    }
+
+    void deallocate(T* pointer, size_t n){
+        if (n != 1)
+            ::operator delete(pointer);
+        else
+            BlockPool<sizeof(T)>::getInstance().deallocate(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#include "PrintBuffer.h"
+
+PrintBuffer::PrintBuffer(size_t capacity) : entries(std::max<size_t>(capacity, 1)), total(0) {}
+
+void PrintBuffer::append(std::time_t time, int line, int core, int count){
+    // Only the last capacity lines of a long run survive, so skip straight to them
+    int skip = std::max(0, count - static_cast<int>(entries.size()));
+    total += skip;
+
+    for (int i = skip; i < count; ++i){
+        Entry &entry = entries[total % entries.size()];
+        entry.time = time;
+        entry.line = line + i;
+        entry.core = static_cast<int16_t>(core);
+        ++total;
+    }
+}
+
+uint64_t PrintBuffer::read(uint64_t from, std::vector<Entry> &out) const{
+    uint64_t oldest = total > entries.size() ? total - entries.size() : 0;
+
+    for (uint64_t i = std::max(from, oldest); i < total; ++i)
+        out.push_back(entries[i % entries.size()]);
+
+    return total;
+}
+
+uint64_t PrintBuffer::getTotal() const{
+    return total;
+}
+
+size_t PrintBuffer::getCapacity() const{
+    return entries.size();
+}
+
+std::string PrintBuffer::format(const Entry &entry, const std::string &message){
+    std::ostringstream text;
+    text << "(" << std::put_time(std::localtime(&entry.time), "%m/%d/%Y, %I:%M:%S %p") << ") Core:" << entry.core
+         << " \"" << message << "\"";
+    return text.str();
+}
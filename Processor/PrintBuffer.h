@@ -0,0 +1,40 @@
+#pragma once
+#ifndef PRINT_BUFFER_H
+#define PRINT_BUFFER_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// Bounded ring of a process's PRINT output. Only the time, core and line of each PRINT are
+// recorded; the text is formatted when someone reads it, so printing never touches a stream.
+// Not synchronized, the owning process's mutex guards it.
+class PrintBuffer{
+public:
+    struct Entry{
+        std::time_t time;
+        int32_t line;
+        int16_t core;
+    };
+
+    explicit PrintBuffer(size_t capacity);
+
+    // Records count consecutive PRINT lines starting at line
+    void append(std::time_t time, int line, int core, int count);
+
+    // Copies the entries numbered from onwards that are still held and returns the number of the
+    // next entry; anything older was overwritten
+    uint64_t read(uint64_t from, std::vector<Entry> &out) const;
+
+    uint64_t getTotal() const;
+    size_t getCapacity() const;
+
+    static std::string format(const Entry &entry, const std::string &message);
+
+private:
+    std::vector<Entry> entries;
+    uint64_t total;
+};
+
+#endif
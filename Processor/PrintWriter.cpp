@@ -0,0 +1,166 @@
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+
+#include "PrintWriter.h"
+#include "PrintBuffer.h"
+#include "ProcessTable.h"
+#include "Process.h"
+
+PrintWriter* PrintWriter::sharedInstance = nullptr;
+
+PrintWriter& PrintWriter::getInstance(){
+    if (!sharedInstance)
+        initialize();
+
+    return *sharedInstance;
+}
+
+void PrintWriter::initialize(){
+    if (!sharedInstance)
+        sharedInstance = new PrintWriter();
+}
+
+void PrintWriter::destroy(){
+    if (sharedInstance){
+        delete sharedInstance;
+        sharedInstance = nullptr;
+    }
+}
+
+PrintWriter::PrintWriter() : enabled(false), running(false), writtenLines(0), droppedLines(0) {}
+
+PrintWriter::~PrintWriter(){
+    stop();
+}
+
+void PrintWriter::setEnabled(bool enabled){
+    std::lock_guard<std::mutex> lock(mutex);
+    this->enabled = enabled;
+}
+
+bool PrintWriter::isEnabled() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return enabled;
+}
+
+void PrintWriter::start(){
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled || running)
+        return;
+
+    std::error_code error;
+    std::filesystem::create_directories(DIRECTORY, error);
+
+    running = true;
+    writerThread = std::thread(&PrintWriter::run, this);
+}
+
+void PrintWriter::stop(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running)
+            return;
+        running = false;
+    }
+
+    wakeup.notify_all();
+    if (writerThread.joinable())
+        writerThread.join();
+}
+
+void PrintWriter::watch(uint32_t slot){
+    std::shared_ptr<Process> process = ProcessTable::getInstance().getSharedProcess(slot);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (enabled && process)
+        watched.push_back(std::move(process));
+}
+
+void PrintWriter::run(){
+    while (true){
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [this](){ return !running; });
+            stopping = !running;
+        }
+
+        // One last pass on the way out so nothing printed before shutdown is lost
+        drain();
+
+        if (stopping)
+            break;
+    }
+}
+
+void PrintWriter::drain(){
+    ProcessTable& table = ProcessTable::getInstance();
+    std::vector<std::shared_ptr<Process>> processes;
+    std::vector<Process*> done;
+    std::vector<PrintBuffer::Entry> entries;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        processes = watched;
+    }
+
+    for (const std::shared_ptr<Process> &process : processes){
+        // Checked before reading: once finished or retired from the table, a process prints
+        // nothing more, so this pass is its last
+        bool finished = process->getProcessState() == Process::FINISHED ||
+                        table.getProcess(process->getSlot()) != process.get();
+        uint64_t dropped;
+        entries.clear();
+        {
+            std::lock_guard<std::mutex> lock(process->mutex);
+            if (!process->printBuffer){
+                if (finished)
+                    done.push_back(process.get());
+                continue;
+            }
+
+            uint64_t next = process->printBuffer->read(process->printLogged, entries);
+            dropped = next - process->printLogged - entries.size();
+            process->printLogged = next;
+        }
+
+        if (finished)
+            done.push_back(process.get());
+
+        if (entries.empty())
+            continue;
+
+        // The whole batch goes out in a single write
+        std::string message = process->getPrintMessage();
+        std::string batch;
+        for (const PrintBuffer::Entry &entry : entries){
+            batch += PrintBuffer::format(entry, message);
+            batch += '\n';
+        }
+
+        std::ofstream file(std::string(DIRECTORY) + "/" + process->getName() + ".txt", std::ios::app);
+        file << batch;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        writtenLines += entries.size();
+        droppedLines += dropped;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Process* process : done){
+        watched.erase(std::remove_if(watched.begin(), watched.end(),
+            [process](const std::shared_ptr<Process> &other){ return other.get() == process; }), watched.end());
+    }
+}
+
+uint64_t PrintWriter::getWrittenLines() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return writtenLines;
+}
+
+uint64_t PrintWriter::getDroppedLines() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return droppedLines;
+}
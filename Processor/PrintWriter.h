@@ -0,0 +1,61 @@
+#pragma once
+#ifndef PRINT_WRITER_H
+#define PRINT_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class Process;
+
+// Background thread that drains processes' print buffers into one log file per process, in large
+// batches and away from the cores. Enabled with the 'print-log' config key. A watched process is
+// held by reference until its last lines are written, so neither retiring it nor reusing its
+// slot loses output.
+class PrintWriter{
+public:
+    static PrintWriter& getInstance();
+    static void initialize();
+    static void destroy();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void start();
+    void stop();
+
+    // Called by a process the first time it prints
+    void watch(uint32_t slot);
+
+    uint64_t getWrittenLines() const;
+    uint64_t getDroppedLines() const;
+
+private:
+    PrintWriter();
+    ~PrintWriter();
+    PrintWriter(const PrintWriter&) = delete;
+    PrintWriter& operator=(const PrintWriter&) = delete;
+
+    static constexpr int FLUSH_INTERVAL_MS = 500;
+    static constexpr const char* DIRECTORY = "z_printLogs_z";
+
+    void run();
+    void drain();
+
+    bool enabled;
+    bool running;
+    std::vector<std::shared_ptr<Process>> watched;
+    std::thread writerThread;
+    uint64_t writtenLines;
+    uint64_t droppedLines;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeup;
+    static PrintWriter* sharedInstance;
+};
+
+#endif
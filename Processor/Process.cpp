@@ -1,28 +1,162 @@
+#include <cmath>
+
 #include "Process.h"
-#include "../Command/PrintCommand.h"
 #include "../UI/UI_Manager.h"
+#include "PrintWriter.h"
+#include "ChannelTable.h"
+#include "SyncTable.h"
+#include "../Memory/Memory.h"
+#include "Scheduler.h"
 
 Process::Process(int pid, const std::string &name, RequirementFlags requirementFlags, const std::string &timestamp,
                  int minInstructions, int maxInstructions, int minMem, int maxMem, int minPage, int maxPage)
-    : pid(pid), name(name), requirementFlags(requirementFlags),timestamp(timestamp),
+    : pid(pid), accessRandom(0), requirementFlags(requirementFlags),
     minInstructions(minInstructions), maxInstructions(maxInstructions),
     minMem(minMem), maxMem(maxMem), minPage(minPage), maxPage(maxPage){
 
-        currentState = Process::READY;
-        cpuCoreID = -1;
+        ProcessTable& table = ProcessTable::getInstance();
+        slot = table.allocateSlot();
+        table.setName(slot, name);
+        timestampId = table.intern(timestamp);
+
+        state() = Process::READY;
         commandCounter = 0;
-        currInstruction = 0;
-        generateRandomInstruction(minInstructions, maxInstructions);
-        generateRandomMemReq(minMem, maxMem);
-        generateRandomPageReq(minPage, maxPage);
 
+        // Each PID draws from its own stream, so a run is reproducible under a fixed 'seed'
+        FastRandom random(FastRandom::streamSeed(static_cast<uint64_t>(static_cast<int64_t>(pid))));
+        generateRandomInstruction(random, minInstructions, maxInstructions);
+        generateRandomMemReq(random, minMem, maxMem);
+        generateRandomPageReq(random, minPage, maxPage);
+        accessRandom = FastRandom(random.next());
+        priority = static_cast<int>((instructionSeed >> 32) % priorityLevels);
+        effectivePriority() = static_cast<int16_t>(priority);
+
+        table.length(slot) = numInstruction;
         this->maxInstructions = numInstruction - 1;
 }
 
-void Process::addCommand(ICommand::CommandType commandType){
-    switch (commandType) {
+Process::Process(const Process &parent, int pid, const std::string &name, const std::string &timestamp)
+    : pid(pid), accessRandom(FastRandom::streamSeed(static_cast<uint64_t>(static_cast<int64_t>(pid)))){
+        std::lock_guard<std::mutex> lock(parent.mutex);
+        ProcessTable& table = ProcessTable::getInstance();
+        slot = table.allocateSlot();
+        table.setName(slot, name);
+        timestampId = table.intern(timestamp);
+
+        instructionSeed = parent.instructionSeed;
+        programSeed = parent.programSeed;
+        std::copy(std::begin(parent.variables), std::end(parent.variables), variables);
+        if (parent.heap)
+            heap = std::make_unique<ProcessHeap>(*parent.heap);
+        heapAllocations = parent.heapAllocations;
+        memoryWords = parent.memoryWords;
+        accessPattern = parent.accessPattern;
+        attachedSegments = parent.attachedSegments;
+        forkDepth = parent.forkDepth + 1;
+        priority = parent.priority;
+        effectivePriority() = static_cast<int16_t>(priority);
+        memoryGroup = parent.memoryGroup;
+        cpuGroup = parent.cpuGroup;
+
+        memoryRequired = parent.memoryRequired;
+        commandCounter = parent.commandCounter;
+        requirementFlags = parent.requirementFlags;
+        minInstructions = parent.minInstructions;
+        maxInstructions = parent.maxInstructions;
+        numInstruction = parent.numInstruction;
+        minMem = parent.minMem;
+        maxMem = parent.maxMem;
+        numPage = parent.numPage;
+        minPage = parent.minPage;
+        maxPage = parent.maxPage;
+        memPerPage = parent.memPerPage;
+
+        state() = Process::READY;
+        pc() = parent.pc();
+        table.length(slot) = numInstruction;
+}
+
+Process::~Process(){
+    ProcessTable::getInstance().releaseSlot(slot);
+}
+
+bool Process::fusionEnabled = false;
+int Process::programTemplates = 0;
+int Process::printBufferLines = 100;
+int Process::heapMaxAlloc = 1024;
+int Process::maxForkDepth = 1;
+int Process::priorityLevels = 1;
+
+void Process::executeCurrentCommand(){
+    if (pc() >= numInstruction)
+        return;
+
+    // Instructions are regenerated from the seed instead of being stored per process
+    Instruction instruction = fetchInstruction(pc());
+    uint16_t& var = variables[instruction.var];
+
+    switch (instruction.type) {
         case ICommand::PRINT:
-            commandList.push_back(std::make_shared<PrintCommand>(pid, "Hello WOrld"));
+            print(pc(), 1);
+            break;
+        case ICommand::ADD:
+            var = static_cast<uint16_t>(var + instruction.value);
+            break;
+        case ICommand::SUB:
+            var = static_cast<uint16_t>(var - instruction.value);
+            break;
+        case ICommand::MUL:
+            var = static_cast<uint16_t>(static_cast<uint32_t>(var) * instruction.value);
+            break;
+        case ICommand::DIV:
+            var /= instruction.value;
+            break;
+        case ICommand::MOD:
+            var %= instruction.value;
+            break;
+        case ICommand::SLEEP:
+            // Picked up by run(), which gives the core back for this many scheduler ticks
+            sleepTicks = instruction.value % MAX_SLEEP_TICKS + 1;
+            break;
+        case ICommand::ALLOC:
+            heapAllocate(instruction.value);
+            break;
+        case ICommand::FREE:
+            heapFree(instruction.value);
+            break;
+        case ICommand::READ:
+            accessMemory(var, false);
+            break;
+        case ICommand::WRITE:
+            accessMemory(var, true);
+            break;
+        case ICommand::FORK:
+            // The core's worker creates the child once run() has yielded
+            if (forkDepth < maxForkDepth)
+                forkPending = true;
+            break;
+        case ICommand::ATTACH:
+            attachSegment(instruction.value);
+            break;
+        case ICommand::DETACH:
+            detachSegment(instruction.value);
+            break;
+        case ICommand::SEND:
+            exchangeMessage(instruction.value, var, true);
+            break;
+        case ICommand::RECV:
+            exchangeMessage(instruction.value, var, false);
+            break;
+        case ICommand::LOCK:
+        case ICommand::UNLOCK:
+        case ICommand::SEM_WAIT:
+        case ICommand::SEM_SIGNAL:
+            synchronize(instruction.type, instruction.value);
+            break;
+        case ICommand::IO:
+            // Likewise for IO, which blocks until the device completes the request
+            ioPending = true;
+            ioOperand = instruction.value;
             break;
         // can add more
         default:
@@ -30,70 +164,344 @@ void Process::addCommand(ICommand::CommandType commandType){
     }
 }
 
-void Process::executeCurrentCommand() const{
-    if (commandCounter < static_cast<int>(commandList.size())){
-        commandList[commandCounter]->execute();
+int Process::executeNextCommand(int maxLines){
+    if (!fusionEnabled || maxLines <= 1){
+        executeCurrentCommand();
+        return 1;
     }
+
+    return executeFusedCommand(std::min(maxLines, MAX_FUSED_LINES));
 }
 
-void Process::moveToNextLine(){
-    if (commandCounter < static_cast<int>(commandList.size())){
-        commandCounter++;
-        if (commandCounter == static_cast<int>(commandList.size())){
-            currentState = FINISHED;
+int Process::executeFusedCommand(int maxLines){
+    int start = pc();
+    int end = std::min(numInstruction, start + maxLines);
+    Instruction first = fetchInstruction(start);
+    int line = start + 1;
+
+    if (first.type == ICommand::PRINT){
+        // A run of PRINTs of the same constant string only needs one store
+        while (line < end && fetchInstruction(line).type == ICommand::PRINT)
+            ++line;
+
+        print(start, line - start);
+    }
+    else if (first.type == ICommand::ADD || first.type == ICommand::SUB || first.type == ICommand::MUL){
+        // ADD/SUB/MUL on one variable are affine mod 2^16 (v * mul + add), so a run of them composes
+        uint32_t mul = 1;
+        uint32_t add = 0;
+        Instruction next = first;
+
+        while (true){
+            if (next.type == ICommand::ADD)
+                add = (add + next.value) & 0xFFFF;
+            else if (next.type == ICommand::SUB)
+                add = (add - next.value) & 0xFFFF;
+            else{
+                mul = (mul * next.value) & 0xFFFF;
+                add = (add * next.value) & 0xFFFF;
+            }
+
+            if (line >= end)
+                break;
+
+            next = fetchInstruction(line);
+            if (next.var != first.var || (next.type != ICommand::ADD && next.type != ICommand::SUB && next.type != ICommand::MUL))
+                break;
+            ++line;
         }
+
+        uint16_t& var = variables[first.var];
+        var = static_cast<uint16_t>(var * mul + add);
     }
+    else
+        executeCurrentCommand();
+
+    // Leave the program counter on the last line covered, as if each line ran on its own
+    pc() = line - 1;
+    return line - start;
 }
 
-void Process::executeTask(){
-    for(int i = currInstruction; i < numInstruction; i++){
-        currInstruction = i;
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+// Output only goes into the process's ring buffer; screens format it on demand and the print
+// writer, when enabled, moves it to disk off the cores
+void Process::print(int line, int count){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!printBuffer){
+        printBuffer = std::make_unique<PrintBuffer>(printBufferLines);
+        PrintWriter::getInstance().watch(slot);
     }
 
-    currentState = Process::FINISHED;
+    printBuffer->append(std::time(nullptr), line, ProcessTable::getInstance().core(slot), count);
 }
 
-void Process::executeTask(int quantumCycles){
-    auto startTime = std::chrono::steady_clock::now();
-    auto endTime = startTime + std::chrono::milliseconds(quantumCycles * 1000);
+// ALLOC takes heap memory for a block of up to heap-max-alloc bytes. When the heap is out of room
+// it grows by whole pages, which have to come from Memory like the rest of the process. A process
+// with fewer KB than pages has pages of 0 KB and cannot have a heap, so its ALLOCs fail.
+void Process::heapAllocate(uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    if (memPerPage == 0){
+        ProcessHeap::recordFailure();
+        return;
+    }
 
-    for (int i = currInstruction; i < numInstruction; ++i){
-        currInstruction = i;
+    size_t bytes = operand % heapMaxAlloc + 1;
 
-        if (std::chrono::steady_clock::now() >= endTime)
-            break;
+    // The heap starts right after the memory the process was created with
+    if (!heap)
+        heap = std::make_unique<ProcessHeap>(static_cast<uint64_t>(memoryRequired) * 1024, memPerPage * 1024);
+
+    size_t pages = heap->pagesNeeded(bytes);
+    if (pages > 0){
+        // Growth counts against the commit limit like the memory the process was admitted with
+        Scheduler& scheduler = Scheduler::getInstance();
+        if (!scheduler.commitGrowth(this, pages * memPerPage)){
+            ProcessHeap::recordFailure();
+            return;
+        }
+
+        if (!Memory::getInstance().growProcess(this, pages)){
+            scheduler.releaseGrowth(this, pages * memPerPage);
+            ProcessHeap::recordFailure();
+            return;
+        }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        heap->grow(pages);
+        numPage += static_cast<int>(pages);
+        memoryRequired += pages * memPerPage;
     }
 
-    currentState = (currInstruction >= maxInstructions) ? Process::FINISHED : Process::RUNNING;
+    uint64_t address = heap->allocate(bytes);
+    if (address)
+        heapAllocations.push_back(address);
+    else
+        ProcessHeap::recordFailure();
 }
 
-std::vector<char> Process::getPageData(size_t pageIndex) const{
+// FREE releases one of the live blocks, picked by the operand. Pages freed at the top of the
+// heap go back to Memory.
+void Process::heapFree(uint16_t operand){
     std::lock_guard<std::mutex> lock(mutex);
-    if (pageIndex < pageData.size())
-        return pageData[pageIndex];
-    return {};
+    if (heapAllocations.empty())
+        return;
+
+    size_t index = operand % heapAllocations.size();
+    uint64_t address = heapAllocations[index];
+    heapAllocations[index] = heapAllocations.back();
+    heapAllocations.pop_back();
+
+    size_t released = heap->free(address);
+    if (released > 0){
+        Memory::getInstance().shrinkProcess(this, released);
+        Scheduler::getInstance().releaseGrowth(this, released * memPerPage);
+        numPage -= static_cast<int>(released);
+        memoryRequired -= released * memPerPage;
+    }
 }
 
-void Process::setPageData(size_t pageIndex, const std::vector<char>& data){
+// READ and WRITE move one word between a variable and the process's memory, at the next address
+// of the configured access pattern. Memory translates it and charges faults as stall ticks.
+void Process::accessMemory(uint16_t &var, bool write){
     std::lock_guard<std::mutex> lock(mutex);
-    if (pageIndex < pageData.size())
-        pageData[pageIndex] = data;
-    else if (pageIndex == pageData.size())
-        pageData.push_back(data);
+    uint64_t spaceBytes = static_cast<uint64_t>(numPage) * memPerPage * IMemoryAllocator::FRAME_BYTES;
+    if (spaceBytes == 0)
+        return;
+
+    // With segments attached, the access lands in the process's own memory or one of them, evenly
+    if (!attachedSegments.empty()){
+        int target = accessRandom.nextInt(0, static_cast<int>(attachedSegments.size()));
+        if (target > 0){
+            Memory& memory = Memory::getInstance();
+            uint64_t offset = accessRandom.next() % memory.getSegmentBytes();
+            stallTicks += memory.accessSegment(this, attachedSegments[target - 1], offset, var, write);
+            return;
+        }
+    }
+
+    uint64_t address = accessPattern.next(accessRandom, spaceBytes);
+    stallTicks += Memory::getInstance().accessMemory(this, address, write);
+
+    if (write)
+        memoryWords[address] = var;
+    else{
+        auto it = memoryWords.find(address);
+        var = (it != memoryWords.end()) ? it->second : 0;
+    }
+}
+
+// ATTACH maps the segment picked by the operand into the process; DETACH unmaps one of the
+// attached segments. Both do nothing without the paging allocator.
+void Process::attachSegment(uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    Memory& memory = Memory::getInstance();
+    if (memory.getSegmentCount() == 0)
+        return;
+
+    int segment = operand % memory.getSegmentCount();
+    if (std::find(attachedSegments.begin(), attachedSegments.end(), segment) == attachedSegments.end() &&
+        memory.attachSegment(this, segment))
+        attachedSegments.push_back(segment);
+}
+
+void Process::detachSegment(uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    if (attachedSegments.empty())
+        return;
+
+    size_t index = operand % attachedSegments.size();
+    Memory::getInstance().detachSegment(this, attachedSegments[index]);
+    attachedSegments.erase(attachedSegments.begin() + index);
+}
+
+// SEND puts the variable on the channel picked by the operand and RECV takes the next message
+// into it. When the channel is full or empty, run() yields so the scheduler can park the process.
+void Process::exchangeMessage(uint16_t operand, uint16_t &var, bool send){
+    ChannelTable& channels = ChannelTable::getInstance();
+    bool block = !channelRetry;
+    channelRetry = false;
+
+    bool done = send ? channels.send(this, operand, var, block) : channels.receive(this, operand, var, block);
+    if (!done){
+        channelWait = operand;
+        channelWaitSend = send;
+    }
+}
+
+// LOCK/UNLOCK work on the lock picked by the operand, SEM_WAIT/SEM_SIGNAL on the semaphore. An
+// acquire that has to wait still completes the line: the object is handed over before the
+// process is woken.
+void Process::synchronize(ICommand::CommandType type, uint16_t operand){
+    SyncTable& sync = SyncTable::getInstance();
+
+    if (type == ICommand::LOCK)
+        syncPending = !sync.lock(this, operand);
+    else if (type == ICommand::SEM_WAIT)
+        syncPending = !sync.wait(this, operand);
+    else if (type == ICommand::UNLOCK)
+        sync.unlock(this, operand);
+    else
+        sync.signal(this, operand);
+
+    syncMutex = type == ICommand::LOCK;
+    syncOperand = operand;
+}
+
+Instruction Process::fetchInstruction(int line){
+    // The last instruction peeked at while fusing is usually the next one executed
+    if (line != fetchedLine){
+        fetchedInstruction = InstructionGenerator::generate(programSeed, instructionSeed, line);
+        fetchedLine = line;
+    }
+
+    return fetchedInstruction;
+}
+
+void Process::moveToNextLine(){
+    if (pc() < numInstruction){
+        pc()++;
+        commandCounter++;
+        if (pc() == numInstruction){
+            state() = FINISHED;
+        }
+    }
+}
+
+// Runs on the calling core until the quantum expires (0 means no limit) or the process finishes
+ProcessTask::YieldReason Process::resume(int quantumMilliseconds){
+    if (!task.valid())
+        task = run();
+
+    quantum = quantumMilliseconds;
+    return task.resume();
+}
+
+ProcessTask Process::run(){
+    int i = pc();
+
+    while (i < numInstruction){
+        auto endTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(quantum);
+
+        for (; i < numInstruction; ){
+            pc() = i;
+
+            auto now = std::chrono::steady_clock::now();
+            if (quantum > 0 && now >= endTime)
+                break;
+
+            // Every line costs a millisecond, so a fused group is cut to what is left of the quantum
+            int maxLines = MAX_FUSED_LINES;
+            if (quantum > 0)
+                maxLines = static_cast<int>(std::max<long long>(1, std::chrono::duration_cast<std::chrono::milliseconds>(endTime - now).count()));
+
+            int lines = executeNextCommand(maxLines);
+
+            // The blocked SEND or RECV stays the current line and runs again after the wait
+            if (channelWait >= 0)
+                break;
+
+            commandCounter += lines;
+
+            // Page faults and memory stalls keep the core busy on top of the instructions themselves
+            std::this_thread::sleep_for(std::chrono::milliseconds(lines + stallTicks));
+            stallTicks = 0;
+            i += lines;
+
+            if (sleepTicks > 0 || ioPending || forkPending || syncPending)
+                break;
+        }
+
+        // Hand the core back; the next dispatch continues from here with a fresh quantum
+        if (channelWait >= 0){
+            co_yield ProcessTask::WAITING_MESSAGE;
+            channelWait = -1;
+            channelRetry = true;
+        }
+        else if (sleepTicks > 0){
+            if (i < numInstruction)
+                pc() = i;
+
+            co_yield ProcessTask::SLEEPING;
+            sleepTicks = 0;
+        }
+        else if (ioPending){
+            if (i < numInstruction)
+                pc() = i;
+
+            co_yield ProcessTask::WAITING_IO;
+            ioPending = false;
+        }
+        else if (forkPending && i < numInstruction){
+            pc() = i;
+            co_yield ProcessTask::FORKED;
+            forkPending = false;
+        }
+        else if (syncPending){
+            // A wait on the last line is dropped since the process finishes anyway
+            if (i < numInstruction){
+                pc() = i;
+                co_yield ProcessTask::WAITING_SYNC;
+            }
+            syncPending = false;
+        }
+        else if (i < numInstruction)
+            co_yield ProcessTask::QUANTUM_EXPIRED;
+    }
+
+    state() = Process::FINISHED;
 }
 
-void Process::generateRandomInstruction(int min, int max){
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(min, max);
+void Process::generateRandomInstruction(FastRandom &random, int min, int max){
+    numInstruction = random.nextInt(min, max);
+    instructionSeed = random.next();
 
-    numInstruction = dis(gen);
+    // With program templates, processes share opcode sequences and only differ in their operands
+    if (programTemplates > 0)
+        programSeed = InstructionGenerator::templateSeed(static_cast<int>(random.next() % programTemplates));
+    else
+        programSeed = instructionSeed;
 }
 
-void Process::generateRandomMemReq(int minMem, int maxMem){
+void Process::generateRandomMemReq(FastRandom &random, int minMem, int maxMem){
     if (minMem <= 0 || maxMem <= 0 || minMem > maxMem){
         std::cerr << "Invalid memory range" << std::endl;
         return;
@@ -107,24 +515,32 @@ void Process::generateRandomMemReq(int minMem, int maxMem){
         return;
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(minExp, maxExp);
-
-    int exp = dis(gen);
+    int exp = random.nextInt(minExp, maxExp);
     memoryRequired = std::pow(2, exp);
 }
 
-void Process::generateRandomPageReq(int minPage, int maxPage){
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(minPage, maxPage);
-
-    numPage = dis(gen);
+void Process::generateRandomPageReq(FastRandom &random, int minPage, int maxPage){
+    numPage = random.nextInt(minPage, maxPage);
     
     memPerPage = memoryRequired / numPage;
 }
 
+void Process::setFusionEnabled(bool enabled){
+    fusionEnabled = enabled;
+}
+
+bool Process::isFusionEnabled(){
+    return fusionEnabled;
+}
+
+void Process::setProgramTemplates(int templates){
+    programTemplates = templates;
+}
+
+int Process::getProgramTemplates(){
+    return programTemplates;
+}
+
 int Process::getPID() const{
     return pid;
 }
@@ -134,15 +550,15 @@ int Process::getCommandCounter() const{
 }
 
 std::string Process::getName() const{
-    return name;
+    return ProcessTable::getInstance().getName(slot);
 }
 
 std::string Process::getTimestamp() const{
-    return timestamp;
+    return ProcessTable::getInstance().getString(timestampId);
 }
 
 int Process::getCpuCoreID() const{
-    return cpuCoreID;
+    return ProcessTable::getInstance().core(slot);
 };
 
 int Process::getMinInstructions() const{
@@ -154,7 +570,7 @@ int Process::getMaxInstructions() const{
 };
 
 int Process::getCurrInstructions() const{
-    return currInstruction;
+    return pc();
 };
 
 size_t Process::getMemRequired() const{
@@ -170,5 +586,144 @@ int Process::getNumPage() const{
 }
 
 Process::ProcessState Process::getProcessState() const {
-    return currentState;
+    return static_cast<ProcessState>(state());
+}
+
+void Process::setProcessState(ProcessState newState){
+    state() = newState;
+}
+
+void Process::setCpuCoreID(int coreID){
+    ProcessTable::getInstance().core(slot) = static_cast<int16_t>(coreID);
+}
+
+void* Process::getAllocatedMemory() const{
+    return ProcessTable::getInstance().memoryHandle(slot);
+}
+
+void Process::setAllocatedMemory(void* memory){
+    ProcessTable::getInstance().memoryHandle(slot) = memory;
+}
+
+uint32_t Process::getSlot() const{
+    return slot;
+}
+
+uint64_t Process::getInstructionSeed() const{
+    return instructionSeed;
+}
+
+uint64_t Process::getProgramSeed() const{
+    return programSeed;
+}
+
+uint16_t Process::getVariable(int index) const{
+    return variables[index];
+}
+
+std::string Process::getPrintMessage() const{
+    return "Hello world from " + getName() + "!";
+}
+
+std::vector<std::string> Process::getOutput() const{
+    std::vector<PrintBuffer::Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (printBuffer)
+            printBuffer->read(0, entries);
+    }
+
+    std::string message = getPrintMessage();
+    std::vector<std::string> output;
+    for (const PrintBuffer::Entry &entry : entries)
+        output.push_back(PrintBuffer::format(entry, message));
+
+    return output;
+}
+
+size_t Process::getHeapBytes() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return heap ? heap->getBytesInUse() : 0;
+}
+
+size_t Process::getHeapPages() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return heap ? heap->getPageCount() : 0;
+}
+
+size_t Process::getHeapAllocations() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return heapAllocations.size();
+}
+
+void Process::getCacheStatistics(uint64_t &accesses, uint64_t &l1Misses, uint64_t &l2Misses) const{
+    std::lock_guard<std::mutex> lock(mutex);
+    accesses = cacheAccesses;
+    l1Misses = this->l1Misses;
+    l2Misses = this->l2Misses;
+}
+
+size_t Process::getWorkingSet() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return workingSetKB;
+}
+
+int Process::getPriority() const{
+    return priority;
+}
+
+int Process::getEffectivePriority() const{
+    return effectivePriority();
+}
+
+bool Process::isOomKilled() const{
+    return oomKilled;
+}
+
+int Process::getMemoryGroup() const{
+    return memoryGroup;
+}
+
+void Process::setMemoryGroup(int group){
+    memoryGroup = group;
+}
+
+int Process::getCpuGroup() const{
+    return cpuGroup;
+}
+
+void Process::setCpuGroup(int group){
+    cpuGroup = group;
+}
+
+void Process::setPriorityLevels(int levels){
+    priorityLevels = std::max(1, levels);
+}
+
+int Process::getPriorityLevels(){
+    return priorityLevels;
+}
+
+void Process::setMaxForkDepth(int depth){
+    maxForkDepth = std::max(0, depth);
+}
+
+int Process::getMaxForkDepth(){
+    return maxForkDepth;
+}
+
+void Process::setHeapMaxAlloc(int bytes){
+    heapMaxAlloc = std::max(1, bytes);
+}
+
+int Process::getHeapMaxAlloc(){
+    return heapMaxAlloc;
+}
+
+void Process::setPrintBufferLines(int lines){
+    printBufferLines = std::max(1, lines);
+}
+
+int Process::getPrintBufferLines(){
+    return printBufferLines;
 }
\ No newline at end of file
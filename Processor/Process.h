@@ -10,10 +10,18 @@
 #include <mutex>
 #include <iostream>
 #include <fstream>
-#include <random>
 #include <unordered_map>
+#include <algorithm>
+#include <atomic>
 
 #include "../Command/ICommand.h"
+#include "../Command/InstructionGenerator.h"
+#include "ProcessTable.h"
+#include "FastRandom.h"
+#include "ProcessTask.h"
+#include "PrintBuffer.h"
+#include "../Memory/ProcessHeap.h"
+#include "../Memory/AccessPattern.h"
 
 class Process{
 public:
@@ -29,15 +37,35 @@ public:
         READY,
         RUNNING,
         WAITING,
-        FINISHED
+        FINISHED,
+        SLEEPING,
+        BLOCKED,
+        SUSPENDED
     };
 
     Process(int pid, const std::string &name, RequirementFlags requirementFlags, const std::string &timestamp,
             int minInstructions, int maxInstructions, int minMem, int maxMem, int minPage, int maxPage);
-    void addCommand(ICommand::CommandType commandType);
-    void executeCurrentCommand() const;
+    // Child of a FORK: continues from the parent's next line with a copy of its variables, heap and memory
+    Process(const Process &parent, int pid, const std::string &name, const std::string &timestamp);
+    ~Process();
+    void executeCurrentCommand();
+    // Runs the current line, or with fusion on a group of at most maxLines lines, and returns how many ran
+    int executeNextCommand(int maxLines = MAX_FUSED_LINES);
     void moveToNextLine();
 
+    static void setFusionEnabled(bool enabled);
+    static bool isFusionEnabled();
+    static void setProgramTemplates(int templates);
+    static int getProgramTemplates();
+    static void setPrintBufferLines(int lines);
+    static int getPrintBufferLines();
+    static void setHeapMaxAlloc(int bytes);
+    static int getHeapMaxAlloc();
+    static void setMaxForkDepth(int depth);
+    static int getMaxForkDepth();
+    static void setPriorityLevels(int levels);
+    static int getPriorityLevels();
+
     int getPID() const;
     int getCommandCounter() const;
     std::string getName() const;
@@ -50,33 +78,129 @@ public:
     size_t getMemPerPage() const;
     int getNumPage() const;
     ProcessState getProcessState() const;
-    void* allocatedMemory = nullptr;
+    void setProcessState(ProcessState newState);
+    void setCpuCoreID(int coreID);
+    void* getAllocatedMemory() const;
+    void setAllocatedMemory(void* memory);
+    uint32_t getSlot() const;
+    uint64_t getInstructionSeed() const;
+    uint64_t getProgramSeed() const;
+    uint16_t getVariable(int index) const;
+    std::string getPrintMessage() const;
+    std::vector<std::string> getOutput() const;
+    size_t getHeapBytes() const;
+    size_t getHeapPages() const;
+    size_t getHeapAllocations() const;
+    void getCacheStatistics(uint64_t &accesses, uint64_t &l1Misses, uint64_t &l2Misses) const;
+    // KB of memory referenced recently, as of the last load-control sample
+    size_t getWorkingSet() const;
+    // 0 is the most urgent. The effective priority is raised above the process's own while a more
+    // urgent process waits on a lock it holds.
+    int getPriority() const;
+    int getEffectivePriority() const;
+    // Finished because the OOM killer picked it, not because it ran to the end
+    bool isOomKilled() const;
+    // Memory and CPU groups the process is charged to, batch unless set before it is queued
+    int getMemoryGroup() const;
+    void setMemoryGroup(int group);
+    int getCpuGroup() const;
+    void setCpuGroup(int group);
 
     std::vector<size_t> allocatedFrames;
 
-    void executeTask();
-    void executeTask(int quantumCycles);
-    void generateRandomInstruction(int min, int max);
-    void generateRandomMemReq(int minMem, int maxMem);
-    void generateRandomPageReq(int minPage, int maxPage);
-
-    std::vector<char> getPageData(size_t pageIndex) const;
-    void setPageData(size_t pageIndex, const std::vector<char>& data);
+    ProcessTask::YieldReason resume(int quantumMilliseconds);
+    void generateRandomInstruction(FastRandom &random, int min, int max);
+    void generateRandomMemReq(FastRandom &random, int minMem, int maxMem);
+    void generateRandomPageReq(FastRandom &random, int minPage, int maxPage);
 
 private:
+    static constexpr int MAX_FUSED_LINES = 16;
+    static const int MAX_SLEEP_TICKS = 256;
+    static bool fusionEnabled;
+    static int programTemplates;
+    static int printBufferLines;
+    static int heapMaxAlloc;
+    static int maxForkDepth;
+    static int priorityLevels;
+
+    int executeFusedCommand(int maxLines);
+    void print(int line, int count);
+    void heapAllocate(uint16_t operand);
+    void heapFree(uint16_t operand);
+    void accessMemory(uint16_t &var, bool write);
+    void attachSegment(uint16_t operand);
+    void detachSegment(uint16_t operand);
+    void exchangeMessage(uint16_t operand, uint16_t &var, bool send);
+    void synchronize(ICommand::CommandType type, uint16_t operand);
+    Instruction fetchInstruction(int line);
+    ProcessTask run();
+
+    // Hot fields live in this process's ProcessTable slot
+    int32_t& pc() const { return ProcessTable::getInstance().pc(slot); }
+    uint8_t& state() const { return ProcessTable::getInstance().state(slot); }
+    std::atomic<int16_t>& effectivePriority() const { return ProcessTable::getInstance().priority(slot); }
+
+    uint32_t slot;
     int pid;
-    std::string name;
-    typedef std::vector<std::shared_ptr<ICommand>> CommandList;
-    CommandList commandList;
+    uint32_t timestampId;
+    uint64_t instructionSeed;
+    uint64_t programSeed;
+    uint16_t variables[InstructionGenerator::NUM_VARIABLES] = {};
+    std::unique_ptr<PrintBuffer> printBuffer;
+    uint64_t printLogged = 0;
+    std::unique_ptr<ProcessHeap> heap;
+    std::vector<uint64_t> heapAllocations;
+    // Words stored by WRITE, keyed by address; words never written read as 0
+    std::unordered_map<uint64_t, uint16_t> memoryWords;
+    AccessPattern accessPattern;
+    FastRandom accessRandom;
+    // Shared memory segments attached with ATTACH, kept across swaps so Memory can map them again
+    std::vector<int> attachedSegments;
+    // PAGE_PRESENT/PAGE_DIRTY bits per page while the process is in memory, kept by Memory
+    std::vector<uint8_t> pageFlags;
+    // Reference bits of the last eight samples per page, newest in the top bit, kept by Memory
+    std::vector<uint8_t> referenceHistory;
+    size_t workingSetKB = 0;
+    int sampledCommands = -1;
+    // READ/WRITE accesses that went through the cache model and the ones each level missed, kept by Memory
+    uint64_t cacheAccesses = 0;
+    uint64_t l1Misses = 0;
+    uint64_t l2Misses = 0;
+    int stallTicks = 0;
+    Instruction fetchedInstruction;
+    int fetchedLine = -1;
+    ProcessTask task;
+    int quantum = 0;
+    int sleepTicks = 0;
+    bool ioPending = false;
+    uint16_t ioOperand = 0;
+    // Generations of FORK above this process; FORK does nothing once it reaches max-fork-depth
+    int forkDepth = 0;
+    bool forkPending = false;
+    // Channel a SEND or RECV is waiting on; the instruction runs again, without blocking, once woken
+    int channelWait = -1;
+    bool channelWaitSend = false;
+    bool channelRetry = false;
+    // LOCK or SEM_WAIT that found the object taken; the scheduler parks the process on it
+    bool syncPending = false;
+    bool syncMutex = false;
+    uint16_t syncOperand = 0;
+    int priority = 0;
+    // Memory charged against the commit limit on admission, and whether the process holds swap, kept by the scheduler
+    size_t committedKB = 0;
+    bool swappedOut = false;
+    // Scheduler tick the process was queued at, for the OOM killer's age score
+    uint64_t arrivalTick = 0;
+    bool oomKilled = false;
+    int memoryGroup = 0;
+    int cpuGroup = 0;
+    // KB charged to the memory group while the process holds memory, kept by Memory
+    size_t groupChargedKB = 0;
     size_t memoryRequired;
     int commandCounter;
-    int cpuCoreID = -1;
     RequirementFlags requirementFlags;
-    ProcessState currentState;
-    std::string timestamp;
     int minInstructions;
     int maxInstructions;
-    int currInstruction;
     int numInstruction;
     int minMem;
     int maxMem;
@@ -86,11 +210,17 @@ private:
     size_t memPerPage;
 
     mutable std::mutex mutex;
-    std::vector<std::vector<char>> pageData;
     std::vector<size_t> pages;
 
     friend class ResourceEmulator;
     friend class Scheduler;
+    friend class Benchmark;
+    friend class BatchExecutor;
+    friend class ProcessTable;
+    friend class PrintWriter;
+    friend class Memory;
+    friend class PageMerger;
+    friend class SyncTable;
 };
 
 #endif
\ No newline at end of file
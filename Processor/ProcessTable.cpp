@@ -0,0 +1,177 @@
+#include <algorithm>
+
+#include "ProcessTable.h"
+#include "Process.h"
+
+ProcessTable* ProcessTable::sharedInstance = nullptr;
+
+ProcessTable& ProcessTable::getInstance(){
+    if (!sharedInstance)
+        initialize();
+
+    return *sharedInstance;
+}
+
+void ProcessTable::initialize(){
+    if (!sharedInstance)
+        sharedInstance = new ProcessTable();
+}
+
+void ProcessTable::destroy(){
+    if (sharedInstance){
+        delete sharedInstance;
+        sharedInstance = nullptr;
+    }
+}
+
+ProcessTable::ProcessTable() : nextSlot(0){
+    for (uint32_t i = 0; i < MAX_CHUNKS; ++i){
+        hotChunks[i].store(nullptr);
+        coldChunks[i].store(nullptr);
+    }
+}
+
+ProcessTable::~ProcessTable(){
+    for (uint32_t i = 0; i < MAX_CHUNKS; ++i){
+        delete hotChunks[i].load();
+        delete coldChunks[i].load();
+    }
+}
+
+uint32_t ProcessTable::allocateSlot(){
+    std::lock_guard<std::mutex> lock(slotMutex);
+    uint32_t index;
+
+    if (!freeSlots.empty()){
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else{
+        index = nextSlot.load();
+        uint32_t chunk = index >> CHUNK_BITS;
+        if (chunk >= MAX_CHUNKS)
+            throw std::runtime_error("Process table is full");
+
+        if (!hotChunks[chunk].load()){
+            hotChunks[chunk].store(new HotChunk(), std::memory_order_release);
+            coldChunks[chunk].store(new ColdChunk(), std::memory_order_release);
+        }
+        nextSlot.store(index + 1);
+    }
+
+    state(index) = 0;
+    core(index) = -1;
+    pc(index) = 0;
+    length(index) = 0;
+    memoryHandle(index) = nullptr;
+
+    return index;
+}
+
+void ProcessTable::releaseSlot(uint32_t index){
+    std::lock_guard<std::mutex> lock(slotMutex);
+    state(index) = 0xFF;
+    cold(index)->pointers[index & CHUNK_MASK].store(nullptr, std::memory_order_release);
+    cold(index)->processes[index & CHUNK_MASK].store(nullptr, std::memory_order_release);
+    std::string().swap(cold(index)->names[index & CHUNK_MASK]);
+    freeSlots.push_back(index);
+}
+
+void ProcessTable::registerProcess(const std::shared_ptr<Process> &process){
+    uint32_t index = process->getSlot();
+    std::string name;
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        cold(index)->processes[index & CHUNK_MASK].store(process, std::memory_order_release);
+        cold(index)->pointers[index & CHUNK_MASK].store(process.get(), std::memory_order_release);
+        name = cold(index)->names[index & CHUNK_MASK];
+    }
+
+    std::lock_guard<std::mutex> lock(nameMutex);
+    slotsByName[name] = index;
+}
+
+// Drops the table's reference. Once nothing else holds the process, its destructor hands the
+// slot back for reuse, so the reference is released outside slotMutex.
+void ProcessTable::unregisterProcess(uint32_t index){
+    std::shared_ptr<Process> owner;
+    std::string name;
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        cold(index)->pointers[index & CHUNK_MASK].store(nullptr, std::memory_order_release);
+        owner = cold(index)->processes[index & CHUNK_MASK].exchange(nullptr, std::memory_order_acq_rel);
+        name = cold(index)->names[index & CHUNK_MASK];
+    }
+    if (!owner)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(nameMutex);
+        auto it = slotsByName.find(name);
+        if (it != slotsByName.end() && it->second == index)
+            slotsByName.erase(it);
+    }
+}
+
+uint32_t ProcessTable::findByName(const std::string &name) const{
+    std::lock_guard<std::mutex> lock(nameMutex);
+    auto it = slotsByName.find(name);
+    return it != slotsByName.end() ? it->second : NONE;
+}
+
+Process* ProcessTable::getProcess(uint32_t index) const{
+    return cold(index)->pointers[index & CHUNK_MASK].load(std::memory_order_acquire);
+}
+
+std::shared_ptr<Process> ProcessTable::getSharedProcess(uint32_t index) const{
+    return cold(index)->processes[index & CHUNK_MASK].load(std::memory_order_acquire);
+}
+
+void ProcessTable::setName(uint32_t index, const std::string &name){
+    std::lock_guard<std::mutex> lock(slotMutex);
+    cold(index)->names[index & CHUNK_MASK] = name;
+}
+
+std::string ProcessTable::getName(uint32_t index) const{
+    std::lock_guard<std::mutex> lock(slotMutex);
+    return cold(index)->names[index & CHUNK_MASK];
+}
+
+uint32_t ProcessTable::intern(const std::string &text){
+    std::lock_guard<std::mutex> lock(stringMutex);
+
+    auto it = stringIds.find(text);
+    if (it != stringIds.end())
+        return it->second;
+
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.push_back(text);
+    stringIds.emplace(text, id);
+
+    return id;
+}
+
+std::string ProcessTable::getString(uint32_t id) const{
+    std::lock_guard<std::mutex> lock(stringMutex);
+    return strings[id];
+}
+
+uint32_t ProcessTable::size() const{
+    return nextSlot.load();
+}
+
+uint32_t ProcessTable::countInState(uint8_t state) const{
+    uint32_t count = 0;
+    uint32_t end = nextSlot.load();
+
+    // Only the state arrays are touched, CHUNK_SIZE bytes at a time
+    for (uint32_t base = 0; base < end; base += CHUNK_SIZE){
+        const uint8_t* states = hot(base)->states;
+        uint32_t limit = std::min(CHUNK_SIZE, end - base);
+
+        for (uint32_t i = 0; i < limit; ++i)
+            count += (states[i] == state);
+    }
+
+    return count;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+#include <unordered_map>
+
+class Process;
+
+// Dense table of process control blocks. Every process owns one slot; the fields the scheduler
+// scans (state, program counter, length, core, memory handle, priority) live in structure-of-arrays chunks
+// so a scan over many processes only touches those arrays. Chunks never move once created, so the
+// hot fields can be read from any thread. A slot's process is published through atomic pointers
+// that only registering and unregistering write, under slotMutex, so lookups take no lock; the
+// name of a slot is read and written under slotMutex. Timestamps repeat across processes and are
+// interned as 32-bit ids; names are unique and stored per slot.
+class ProcessTable{
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+    static constexpr uint32_t CHUNK_BITS = 12;
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static constexpr uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+    static constexpr uint32_t MAX_CHUNKS = 1024;
+
+    static ProcessTable& getInstance();
+    static void initialize();
+    static void destroy();
+
+    uint32_t allocateSlot();
+    void releaseSlot(uint32_t index);
+
+    void registerProcess(const std::shared_ptr<Process> &process);
+    void unregisterProcess(uint32_t index);
+    uint32_t findByName(const std::string &name) const;
+    Process* getProcess(uint32_t index) const;
+    std::shared_ptr<Process> getSharedProcess(uint32_t index) const;
+    void setName(uint32_t index, const std::string &name);
+    std::string getName(uint32_t index) const;
+
+    uint32_t intern(const std::string &text);
+    std::string getString(uint32_t id) const;
+
+    uint32_t size() const;
+    uint32_t countInState(uint8_t state) const;
+
+    uint8_t& state(uint32_t index) { return hot(index)->states[index & CHUNK_MASK]; }
+    int16_t& core(uint32_t index) { return hot(index)->cores[index & CHUNK_MASK]; }
+    int32_t& pc(uint32_t index) { return hot(index)->pcs[index & CHUNK_MASK]; }
+    int32_t& length(uint32_t index) { return hot(index)->lengths[index & CHUNK_MASK]; }
+    void*& memoryHandle(uint32_t index) { return hot(index)->memoryHandles[index & CHUNK_MASK]; }
+    // Effective priority, raised by priority inheritance from whichever thread releases a lock
+    std::atomic<int16_t>& priority(uint32_t index) { return hot(index)->priorities[index & CHUNK_MASK]; }
+
+private:
+    struct HotChunk{
+        uint8_t states[CHUNK_SIZE];
+        int16_t cores[CHUNK_SIZE];
+        int32_t pcs[CHUNK_SIZE];
+        int32_t lengths[CHUNK_SIZE];
+        void* memoryHandles[CHUNK_SIZE];
+        std::atomic<int16_t> priorities[CHUNK_SIZE];
+    };
+
+    struct ColdChunk{
+        // The owning reference, and the raw pointer for lookups that do not need ownership
+        std::atomic<std::shared_ptr<Process>> processes[CHUNK_SIZE];
+        std::atomic<Process*> pointers[CHUNK_SIZE];
+        std::string names[CHUNK_SIZE];
+    };
+
+    ProcessTable();
+    ~ProcessTable();
+    ProcessTable(const ProcessTable&) = delete;
+    ProcessTable& operator=(const ProcessTable&) = delete;
+
+    HotChunk* hot(uint32_t index) const { return hotChunks[index >> CHUNK_BITS].load(std::memory_order_acquire); }
+    ColdChunk* cold(uint32_t index) const { return coldChunks[index >> CHUNK_BITS].load(std::memory_order_acquire); }
+
+    std::atomic<HotChunk*> hotChunks[MAX_CHUNKS];
+    std::atomic<ColdChunk*> coldChunks[MAX_CHUNKS];
+    std::atomic<uint32_t> nextSlot;
+    std::vector<uint32_t> freeSlots;
+    mutable std::mutex slotMutex;
+
+    std::deque<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIds;
+    mutable std::mutex stringMutex;
+
+    std::unordered_map<std::string, uint32_t> slotsByName;
+    mutable std::mutex nameMutex;
+
+    static ProcessTable* sharedInstance;
+};
+
+#endif
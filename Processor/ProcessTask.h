@@ -0,0 +1,79 @@
+#pragma once
+#ifndef PROCESS_TASK_H
+#define PROCESS_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Coroutine handle for a process's execution. The process suspends itself with co_yield when it
+// gives up its core, and whichever core worker dispatches it next resumes it from that point.
+class ProcessTask{
+public:
+    enum YieldReason
+    {
+        QUANTUM_EXPIRED,
+        SLEEPING,
+        WAITING_IO,
+        FORKED,
+        WAITING_MESSAGE,
+        WAITING_SYNC,
+        COMPLETED
+    };
+
+    struct promise_type{
+        YieldReason reason = COMPLETED;
+
+        ProcessTask get_return_object(){
+            return ProcessTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // Nothing runs until the first dispatch
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(YieldReason yieldReason) noexcept{
+            reason = yieldReason;
+            return {};
+        }
+
+        void return_void() { reason = COMPLETED; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    ProcessTask() : handle(nullptr) {}
+    explicit ProcessTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    ProcessTask(ProcessTask &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    ProcessTask& operator=(ProcessTask &&other) noexcept{
+        if (this != &other){
+            if (handle)
+                handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    ProcessTask(const ProcessTask&) = delete;
+    ProcessTask& operator=(const ProcessTask&) = delete;
+
+    ~ProcessTask(){
+        if (handle)
+            handle.destroy();
+    }
+
+    // Runs the coroutine until it next suspends and reports why it did
+    YieldReason resume(){
+        if (!handle || handle.done())
+            return COMPLETED;
+
+        handle.resume();
+        return handle.done() ? COMPLETED : handle.promise().reason;
+    }
+
+    bool valid() const { return handle != nullptr; }
+    bool done() const { return !handle || handle.done(); }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+#endif
@@ -1,21 +1,27 @@
 #include "Scheduler.h"
+#include "ObjectPool.h"
+#include "PrintWriter.h"
+#include "ChannelTable.h"
+#include "SyncTable.h"
+#include "../Memory/PageMerger.h"
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <algorithm>
 
 Scheduler* Scheduler::sharedInstance = nullptr;
-int Scheduler::qqCounter = 0;
+std::atomic<int> Scheduler::qqCounter{0};
 
 Scheduler::Scheduler() : schedulerAlgorithm("NULL"), quantumCycles(0), batchProcessFrequency(0),
-    minInstructions(0), maxInstructions(0), delaysPerExecution(0), numCores(0),
+    minInstructions(0), maxInstructions(0), delaysPerExecution(0), maxFinishedProcesses(0), numCores(0),
     running(true){
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
-
     activeCPUTicks = 0;
     idleCPUTicks = 0;
     numPagedIn = 0;
     numPagedOut = 0;
-    runningProcesses.resize(numCores, nullptr);
+    numForks = 0;
+    runningProcesses.resize(numCores, ProcessTable::NONE);
+    startTime = std::chrono::steady_clock::now();
 }
 
 Scheduler::~Scheduler(){
@@ -53,6 +59,44 @@ void Scheduler::getInfo(){
     std::cout << "Delays per Execution: " << delaysPerExecution << std::endl;
     std::cout << "Minimum Page per Process: " << minPage << std::endl;
     std::cout << "Maximum Page per Process: " << maxPage << std::endl;
+    std::cout << "Instruction Fusion: " << (Process::isFusionEnabled() ? "On" : "Off") << std::endl;
+    std::cout << "Instruction Block Lines: " << InstructionGenerator::getBlockLines() << std::endl;
+    std::cout << "Program Templates: " << Process::getProgramTemplates() << std::endl;
+    std::cout << "Seed: " << FastRandom::getSeed() << std::endl;
+    std::cout << "Print Buffer Lines: " << Process::getPrintBufferLines() << std::endl;
+    std::cout << "Print Log: " << (PrintWriter::getInstance().isEnabled() ? "On" : "Off") << std::endl;
+    std::cout << "Sleep Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::SLEEP) << "%" << std::endl;
+    std::cout << "IO Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::IO) << "%" << std::endl;
+    std::cout << "ALLOC/FREE Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::ALLOC) << "% / "
+              << InstructionGenerator::getOpcodePercent(ICommand::FREE) << "%" << std::endl;
+    std::cout << "Heap Max Allocation: " << Process::getHeapMaxAlloc() << " bytes" << std::endl;
+    std::cout << "READ/WRITE Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::READ) << "% / "
+              << InstructionGenerator::getOpcodePercent(ICommand::WRITE) << "%" << std::endl;
+    std::cout << "FORK Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::FORK) << "% (max depth "
+              << Process::getMaxForkDepth() << ")" << std::endl;
+    std::cout << "ATTACH/DETACH Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::ATTACH) << "% / "
+              << InstructionGenerator::getOpcodePercent(ICommand::DETACH) << "%" << std::endl;
+    std::cout << "SEND/RECV Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::SEND) << "% / "
+              << InstructionGenerator::getOpcodePercent(ICommand::RECV) << "%" << std::endl;
+    ChannelTable& channels = ChannelTable::getInstance();
+    std::cout << "Channels: " << channels.getChannelCount() << " x " << channels.getCapacity() << " messages (timeout "
+              << channels.getTimeout() << " ms)" << std::endl;
+    SyncTable& sync = SyncTable::getInstance();
+    std::cout << "Priority Levels: " << Process::getPriorityLevels() << " (inheritance "
+              << (sync.isPriorityInheritanceActive() ? "On" : "Off") << ")" << std::endl;
+    std::cout << "LOCK/UNLOCK Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::LOCK) << "% / "
+              << InstructionGenerator::getOpcodePercent(ICommand::UNLOCK) << "%" << std::endl;
+    std::cout << "SEM_WAIT/SEM_SIGNAL Instructions: " << InstructionGenerator::getOpcodePercent(ICommand::SEM_WAIT) << "% / "
+              << InstructionGenerator::getOpcodePercent(ICommand::SEM_SIGNAL) << "%" << std::endl;
+    std::cout << "Load Control: " << (loadController.isEnabled() ? "On" : "Off") << " (every " << loadController.getInterval()
+              << " ms, suspend at " << loadController.getSuspendRate() << " faults/s, resume at " << loadController.getResumeRate()
+              << " faults/s, min " << loadController.getMinActive() << " active)" << std::endl;
+    std::cout << "CPU Share Mode: " << cpuBandwidth.getShareModeName() << std::endl;
+    for (const CpuBandwidth::GroupUsage &group : cpuBandwidth.getGroupUsage(currentMicroseconds()))
+        std::cout << "CPU Group '" << group.name << "': quota " << (group.quota > 0 ? std::to_string(group.quota) + "/" + std::to_string(group.period) + " ms" : std::string("none"))
+                  << ", weight " << group.weight << std::endl;
+    std::cout << "Sync Objects: " << sync.getLockCount() << " locks, " << sync.getSemaphoreCount() << " semaphores of "
+              << sync.getSemaphoreValue() << " (timeout " << sync.getTimeout() << " ms)" << std::endl;
     std::cout << "--------------------------------" << std::endl;
 
 }
@@ -60,176 +104,450 @@ void Scheduler::getInfo(){
 void Scheduler::addProcess(std::shared_ptr<Process> process){
     std::unique_lock<std::mutex> lock(queueMutex);
 
+    // The table keeps the process alive; queues only carry its slot index
+    ProcessTable::getInstance().registerProcess(process);
+
     // Add the process to queue
-    readyQueue.push(process);
-    process->currentState = Process::WAITING;
+    process->arrivalTick = currentTick();
+    process->setProcessState(Process::WAITING);
+    if (admitProcess(process.get()))
+        readyQueue.push_back(process->getSlot());
+    else
+        pendingAdmissions.push_back(process->getSlot());
+    processCV.notify_one();
+}
+
+void Scheduler::addProcesses(const std::vector<std::shared_ptr<Process>> &processes){
+    std::unique_lock<std::mutex> lock(queueMutex);
+    ProcessTable& table = ProcessTable::getInstance();
+
+    for (const auto& process : processes){
+        table.registerProcess(process);
+        process->arrivalTick = currentTick();
+        process->setProcessState(Process::WAITING);
+        if (admitProcess(process.get()))
+            readyQueue.push_back(process->getSlot());
+        else
+            pendingAdmissions.push_back(process->getSlot());
+    }
+
+    processCV.notify_all();
+}
+
+// Processes are allocated from a pool, so storage freed by retired processes is reused
+std::shared_ptr<Process> Scheduler::createProcess(int pid, const std::string &name){
+    UI_Manager& ui = UI_Manager::getInstance();
+    Process::RequirementFlags reqFlags = { true, 1, true, 512 };
+
+    return std::allocate_shared<Process>(PoolAllocator<Process>(), pid, name, reqFlags, ui.generateTimestamp(),
+                                         minInstructions, maxInstructions, getMinMem(), getMaxMem(), minPage, maxPage);
+}
+
+std::shared_ptr<Process> Scheduler::forkProcess(Process* parent, int pid, const std::string &name){
+    UI_Manager& ui = UI_Manager::getInstance();
+    return std::allocate_shared<Process>(PoolAllocator<Process>(), *parent, pid, name, ui.generateTimestamp());
+}
+
+// The copy is taken under queueMutex with the parent off every core, so no core writes its
+// variables or program counter mid-copy; a parent that is running is refused with nullptr
+std::shared_ptr<Process> Scheduler::forkIdleProcess(Process* parent, int pid, const std::string &name){
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (std::find(runningProcesses.begin(), runningProcesses.end(), parent->getSlot()) != runningProcesses.end())
+        return nullptr;
+
+    return forkProcess(parent, pid, name);
+}
+
+void Scheduler::addForkedProcess(std::shared_ptr<Process> child, Process* parent){
+    std::unique_lock<std::mutex> lock(queueMutex);
+    ProcessTable::getInstance().registerProcess(child);
+    ++numForks;
+    child->arrivalTick = currentTick();
+    child->setProcessState(Process::WAITING);
+
+    // A child over the commit limit waits for admission and is loaded like any other process then
+    if (!admitProcess(child.get())){
+        pendingAdmissions.push_back(child->getSlot());
+        return;
+    }
+
+    // Holding queueMutex keeps the parent from being swapped out while its frames are shared
+    if (parent->getAllocatedMemory() && Memory::getInstance().forkMemory(parent, child.get()))
+        residentProcesses.push_back(child->getSlot());
+
+    readyQueue.push_back(child->getSlot());
     processCV.notify_one();
 }
 
+std::vector<std::shared_ptr<Process>> Scheduler::generateProcesses(int count){
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(count);
+
+    for (int i = 0; i < count; ++i){
+        int pid = UI_Manager::generatePID();
+        processes.push_back(createProcess(pid, "p_" + std::to_string(pid)));
+        processes.back()->setMemoryGroup(Memory::BATCH_GROUP);
+        processes.back()->setCpuGroup(CpuBandwidth::BATCH_GROUP);
+    }
+
+    return processes;
+}
+
+// Records a finished process, dropping the oldest one once more than max-finished-processes are kept
+void Scheduler::retireProcess(uint32_t index){
+    finishedProcesses.push_back(index);
+
+    if (maxFinishedProcesses > 0 && finishedProcesses.size() > maxFinishedProcesses){
+        ProcessTable::getInstance().unregisterProcess(finishedProcesses.front());
+        finishedProcesses.pop_front();
+    }
+}
+
 void Scheduler::run(){
-    if (schedulerAlgorithm == "rr")
-        roundRobin(quantumCycles);
-    else if (schedulerAlgorithm == "fcfs")
+    if (schedulerAlgorithm == "rr" || schedulerAlgorithm == "priority"){
+        startCores();
+        roundRobin();
+    }
+    else if (schedulerAlgorithm == "fcfs"){
+        startCores();
         firstComeFirstServe();
+    }
     else{
         std::cout << "Invalid Scheduler. Program Shutting Down" << std::endl;
     }
 }
 
+// One long-lived worker per core instead of a thread per dispatch
+void Scheduler::startCores(){
+    PrintWriter::getInstance().start();
+    PageMerger::getInstance().start();
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+
+    for (int coreID = 0; coreID < numCores; ++coreID)
+        coreThreads.emplace_back(&Scheduler::coreWorker, this, coreID);
+}
+
+// Resumes whichever process the dispatcher put on this core until its coroutine yields, then
+// requeues or retires it and waits for the next one
+void Scheduler::coreWorker(int coreID){
+    ProcessTable& table = ProcessTable::getInstance();
+    bool isRoundRobin = schedulerAlgorithm == "rr" || schedulerAlgorithm == "priority";
+    int quantum = isRoundRobin ? quantumCycles * 1000 : 0;
+
+    while (true){
+        uint32_t index;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            coreCV.wait(lock, [this, coreID](){ return !running || runningProcesses[coreID] != ProcessTable::NONE; });
+
+            if (!running)
+                return;
+
+            index = runningProcesses[coreID];
+        }
 
+        Process* process = table.getProcess(index);
+        process->setProcessState(Process::RUNNING);
+        Memory::getInstance().switchContext(coreID, process);
+        uint64_t resumedAt = currentMicroseconds();
+        ProcessTask::YieldReason reason = process->resume(quantum);
+        uint64_t yieldedAt = currentMicroseconds();
+
+        if (reason == ProcessTask::FORKED){
+            int pid = UI_Manager::generatePID();
+            addForkedProcess(forkProcess(process, pid, process->getName() + "_" + std::to_string(pid)), process);
+        }
+
+        if (isRoundRobin){
+            generateQuantumCycleTxtFile(qqCounter.fetch_add(1));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            cpuBandwidth.charge(process->getCpuGroup(), yieldedAt - resumedAt, yieldedAt);
+
+            // Processes keep their memory between dispatches; only a finished one gives it back here
+            if (reason == ProcessTask::COMPLETED){
+                ChannelTable::getInstance().release(index);
+                SyncTable::getInstance().release(index);
+                unloadProcess(index);
+                releaseCommit(process);
+                retireProcess(index);
+            }
+            else if (reason == ProcessTask::SLEEPING){
+                process->setProcessState(Process::SLEEPING);
+                sleepQueue.schedule(index, currentTick() + process->sleepTicks);
+            }
+            else if (reason == ProcessTask::WAITING_IO){
+                process->setProcessState(Process::BLOCKED);
+                ResourceEmulator::getInstance().submit(index, process->ioOperand, currentMicroseconds());
+            }
+            else if (reason == ProcessTask::WAITING_MESSAGE &&
+                     ChannelTable::getInstance().park(index, process->channelWait, process->channelWaitSend)){
+                process->setProcessState(Process::BLOCKED);
+            }
+            else if (reason == ProcessTask::WAITING_SYNC &&
+                     SyncTable::getInstance().park(index, process->syncMutex ? SyncTable::MUTEX : SyncTable::SEMAPHORE, process->syncOperand)){
+                process->setProcessState(Process::BLOCKED);
+            }
+            else{
+                process->setProcessState(Process::WAITING);
+                readyQueue.push_back(index);
+            }
+
+            runningProcesses[coreID] = ProcessTable::NONE;
+            processCV.notify_one();
+        }
+    }
+}
+
+
+
+// While processes are asleep, blocked on IO or waiting on a channel or lock the idle loop keeps polling at the execution delay
+// so wakeups stay on time
+int Scheduler::idleDelay() const{
+    if (sleepQueue.size() == 0 && ResourceEmulator::getInstance().getPendingRequests() == 0 &&
+        ChannelTable::getInstance().getParkedProcesses() == 0 && SyncTable::getInstance().getParkedProcesses() == 0)
+        return 100;
+
+    return std::max(1, static_cast<int>(delaysPerExecution * 1000));
+}
+
+uint64_t Scheduler::currentTick() const{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+uint64_t Scheduler::currentMicroseconds() const{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+// Requeues every process whose sleep has run out, whose IO has completed or whose channel or lock
+// wait has ended. Called with queueMutex held.
+void Scheduler::wakeProcesses(){
+    ProcessTable& table = ProcessTable::getInstance();
+
+    wokenProcesses.clear();
+    sleepQueue.advance(currentTick(), wokenProcesses);
+    ResourceEmulator::getInstance().advance(currentMicroseconds(), wokenProcesses);
+    ChannelTable::getInstance().advance(wokenProcesses);
+    SyncTable::getInstance().advance(wokenProcesses);
+
+    for (uint32_t index : wokenProcesses){
+        table.getProcess(index)->setProcessState(Process::WAITING);
+        readyQueue.push_back(index);
+    }
+}
+
+// Once per interval, samples the working sets of the resident processes and lets the load
+// controller suspend or resume one process. Called with queueMutex held.
+void Scheduler::controlLoad(){
+    uint64_t now = currentTick();
+    if (!loadController.isEnabled() || !loadController.isDue(now))
+        return;
+
+    ProcessTable& table = ProcessTable::getInstance();
+    Memory& memory = Memory::getInstance();
+    size_t workingSet = 0;
+    for (uint32_t index : residentProcesses)
+        workingSet += memory.sampleWorkingSet(table.getProcess(index));
+
+    size_t active = table.countInState(Process::WAITING) + table.countInState(Process::RUNNING) +
+                    table.countInState(Process::SLEEPING) + table.countInState(Process::BLOCKED);
+    size_t resumeKB = suspendedProcesses.empty() ? 0 : table.getProcess(suspendedProcesses.front())->getWorkingSet();
+
+    LoadController::Action action = loadController.sample(now, memory.getPageFaults(), workingSet, memory.getMaxSize(),
+                                                          active, suspendedProcesses.size(), resumeKB);
+    if (action == LoadController::SUSPEND)
+        suspendProcess();
+    else if (action == LoadController::RESUME)
+        resumeProcess();
+}
+
+// Suspends the ready process with the largest working set and gives its memory back. Processes
+// asleep or blocked are left alone, since they hold no core and may hold locks others wait on, and
+// so are those not in memory or with no room in swap, since suspending them frees nothing.
+void Scheduler::suspendProcess(){
+    ProcessTable& table = ProcessTable::getInstance();
+    auto victim = readyQueue.end();
+    size_t largest = 0;
+
+    for (auto it = readyQueue.begin(); it != readyQueue.end(); ++it){
+        Process* process = table.getProcess(*it);
+        if (!process->getAllocatedMemory() || !swapHasRoom(process, nullptr))
+            continue;
+
+        size_t workingSet = process->getWorkingSet();
+        if (victim == readyQueue.end() || workingSet > largest){
+            victim = it;
+            largest = workingSet;
+        }
+    }
+
+    if (victim == readyQueue.end())
+        return;
+
+    uint32_t index = *victim;
+    Process* process = table.getProcess(index);
+    readyQueue.erase(victim);
+
+    // With no process waiting on the frames, the write-back is paid by the victim when it resumes
+    process->stallTicks += Memory::getInstance().writeBackPages(process);
+    process->swappedOut = true;
+    swapUsedKB += process->getMemRequired();
+    numPagedOut += process->getNumPage();
+    unloadProcess(index);
+
+    process->setProcessState(Process::SUSPENDED);
+    suspendedProcesses.push_back(index);
+}
+
+void Scheduler::resumeProcess(){
+    uint32_t index = suspendedProcesses.front();
+    suspendedProcesses.pop_front();
+
+    ProcessTable::getInstance().getProcess(index)->setProcessState(Process::WAITING);
+    readyQueue.push_back(index);
+}
+
+// The priority scheduler takes the most urgent ready process, oldest first among equals; the others
+// take the oldest. Processes of throttled CPU groups are passed over, and with a share mode set only
+// the group it picks is considered. NONE when no ready process may run. Called with queueMutex held.
+uint32_t Scheduler::popReadyProcess(){
+    ProcessTable& table = ProcessTable::getInstance();
+    int group = -1;
+
+    if (cpuBandwidth.getShareMode() != CpuBandwidth::NONE){
+        std::vector<bool> ready(cpuBandwidth.getGroupCount(), false);
+        for (uint32_t index : readyQueue)
+            ready[table.getProcess(index)->getCpuGroup()] = true;
+
+        group = cpuBandwidth.selectGroup(ready);
+        if (group < 0)
+            return ProcessTable::NONE;
+    }
+
+    auto eligible = [this, &table, group](uint32_t index){
+        int processGroup = table.getProcess(index)->getCpuGroup();
+        return group < 0 ? !cpuBandwidth.isThrottled(processGroup) : processGroup == group;
+    };
+
+    auto next = readyQueue.end();
+    for (auto it = readyQueue.begin(); it != readyQueue.end(); ++it){
+        if (!eligible(*it))
+            continue;
+        if (next == readyQueue.end())
+            next = it;
+        if (schedulerAlgorithm != "priority")
+            break;
+        if (table.priority(*it) < table.priority(*next))
+            next = it;
+    }
+
+    if (next == readyQueue.end())
+        return ProcessTable::NONE;
+
+    uint32_t index = *next;
+    readyQueue.erase(next);
+    cpuBandwidth.recordDispatch(table.getProcess(index)->getCpuGroup());
+    return index;
+}
 
 void Scheduler::firstComeFirstServe(){
+    ProcessTable& table = ProcessTable::getInstance();
+
     while (running){
         std::unique_lock<std::mutex> lock(queueMutex);
+        wakeProcesses();
+        controlLoad();
+        admitPendingProcesses();
+        cpuBandwidth.advance(currentMicroseconds());
 
         // Wait for processes or termination signal
         if (readyQueue.empty()){
             ++idleCPUTicks;
+            int delay = idleDelay();
             lock.unlock();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
             continue;
         }
 
         // Assign processes to available cores
         for (int coreID = 0; coreID < numCores; ++coreID){
-            if (!runningProcesses[coreID] && !readyQueue.empty()){
-                auto process = readyQueue.front();
-                readyQueue.pop();
-                process->cpuCoreID = coreID;
-                runningProcesses[coreID] = process;
-
-                if (!Memory::getInstance().allocateMemory(process.get())){
-                    process->currentState = Process::WAITING;
-                    runningProcesses[coreID] = nullptr;
-                    readyQueue.push(process);
+            if (runningProcesses[coreID] == ProcessTable::NONE && !readyQueue.empty()){
+                uint32_t index = popReadyProcess();
+                // Every ready process belongs to a throttled group
+                if (index == ProcessTable::NONE)
+                    break;
+
+                Process* process = table.getProcess(index);
+                process->setCpuCoreID(coreID);
+                runningProcesses[coreID] = index;
+
+                if (!loadProcess(process)){
+                    runningProcesses[coreID] = ProcessTable::NONE;
+                    process->setProcessState(Process::WAITING);
+                    readyQueue.push_back(index);
                     continue;
                 }
 
-                // Start a thread for executing the process
+                // The core's worker picks the process up and resumes it
                 ++activeCPUTicks;
-                coreThreads.emplace_back([this, process, coreID](){
-                    process->currentState = Process::RUNNING;
-                    process->executeTask();
-
-                    {
-                        std::lock_guard<std::mutex> lock(queueMutex);
-                        if (process->currentState == Process::FINISHED){
-                            finishedProcesses.push_back(process);
-                            Memory::getInstance().deallocateMemory(process.get());
-                        }
-                        else{
-                            process->currentState = Process::WAITING;
-                            readyQueue.push(process);
-                            Memory::getInstance().deallocateMemory(process.get());
-                        }
-
-                        runningProcesses[coreID] = nullptr;
-                        processCV.notify_one();
-                    }
-                });
+                coreCV.notify_all();
             }
         }
 
         lock.unlock();
         std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(delaysPerExecution * 1000))); // Delays Per Execution
     }
-
-    for (auto& thread : coreThreads)
-        thread.join();
 }
 
-void Scheduler::roundRobin(int quantumCycles){
+void Scheduler::roundRobin(){
+    ProcessTable& table = ProcessTable::getInstance();
+
     while (running){
         std::unique_lock<std::mutex> lock(queueMutex);
+        wakeProcesses();
+        controlLoad();
+        admitPendingProcesses();
+        cpuBandwidth.advance(currentMicroseconds());
 
         if (readyQueue.empty()){
             ++idleCPUTicks;
+            int delay = idleDelay();
             lock.unlock();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
             continue;
         }
 
         // Assign processes to available cores
         for (int coreID = 0; coreID < numCores; ++coreID){
-            if (!runningProcesses[coreID] && !readyQueue.empty()){
-                auto process = readyQueue.front();
-                readyQueue.pop();
-                process->cpuCoreID = coreID;
-                runningProcesses[coreID] = process;
-
-                // Allocate memory and store the returned pointer in the process
-                process->allocatedMemory = Memory::getInstance().allocateMemory(process.get());
-                if (Memory::getInstance().getAllocator()->getName() == "PagingMemoryAllocator"){
-                    if (!process->allocatedMemory){
-                        auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(memory->getAllocator());
-                        Process* processToSwapOut = selectRandomProcessToSwapOut();
-                        
-                        if (processToSwapOut){
-                            numPagedIn += process->getNumPage();
-                            numPagedOut += process->getNumPage();
-                            pagingAllocator->writeProcessToBackingStore(process.get(), processToSwapOut);
-                            pagingAllocator->readProcessFromBackingStore(process.get());
-                        }
-                        
-                        process->currentState = Process::WAITING;
-                        runningProcesses[coreID] = nullptr;
-                        readyQueue.push(process);
-                        continue;
-                    }
-                    else
-                        numPagedIn += process->getNumPage();
-                }
-                else if (Memory::getInstance().getAllocator()->getName() == "FlatMemoryAllocator"){
-                    if (!process->allocatedMemory){
-                        // Simply push process back to queue
-                        process->currentState = Process::WAITING;
-                        runningProcesses[coreID] = nullptr;
-                        readyQueue.push(process);
-                        continue; 
-                    }
+            if (runningProcesses[coreID] == ProcessTable::NONE && !readyQueue.empty()){
+                uint32_t index = popReadyProcess();
+                // Every ready process belongs to a throttled group
+                if (index == ProcessTable::NONE)
+                    break;
+
+                Process* process = table.getProcess(index);
+                process->setCpuCoreID(coreID);
+                runningProcesses[coreID] = index;
+
+                if (!loadProcess(process)){
+                    runningProcesses[coreID] = ProcessTable::NONE;
+                    process->setProcessState(Process::WAITING);
+                    readyQueue.push_back(index);
+                    continue;
                 }
 
-                // Start a thread for executing the process
+                // The core's worker picks the process up and resumes it
                 ++activeCPUTicks;
-                coreThreads.emplace_back([this, process, coreID, quantumCycles](){
-                    process->currentState = Process::RUNNING;
-                    process->executeTask(quantumCycles);
-
-                    generateQuantumCycleTxtFile(qqCounter);
-                    ++qqCounter;
-
-                    {
-                        std::lock_guard<std::mutex> lock(queueMutex);
-
-                        if (process->currentState == Process::FINISHED)
-                        {
-                            finishedProcesses.push_back(process);
-
-                            Memory::getInstance().deallocateMemory(process.get());
-                            numPagedOut += process->getNumPage();
-                        }
-                        else
-                        {
-                            process->currentState = Process::WAITING;
-                            readyQueue.push(process);
-                            
-                            Memory::getInstance().deallocateMemory(process.get());
-                            numPagedOut += process->getNumPage();
-                        }
-
-                        runningProcesses[coreID] = nullptr;
-                        processCV.notify_one();
-                    }
-                });
+                coreCV.notify_all();
             }
         }
 
         lock.unlock();
         std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(delaysPerExecution * 1000))); //Delays Per Execution
     }
-
-    for (auto& thread : coreThreads)
-        thread.join();
 }
 
 void Scheduler::readConfigFile(const std::string& filename){
@@ -246,7 +564,7 @@ void Scheduler::readConfigFile(const std::string& filename){
             if (key == "num-cpu")
             {
                 numCores = std::stoi(value);
-                runningProcesses.resize(numCores, nullptr);
+                runningProcesses.resize(numCores, ProcessTable::NONE);
             }
             else if (key == "scheduler") { schedulerAlgorithm = value; }
             else if (key == "quantum-cycles") { quantumCycles = std::stoi(value); }
@@ -256,29 +574,294 @@ void Scheduler::readConfigFile(const std::string& filename){
             else if (key == "delays-per-exec") { delaysPerExecution = std::stod(value); }
             else if (key == "min-page-per-proc") { minPage = std::stod(value); }
             else if (key == "max-page-per-proc") { maxPage = std::stod(value); }
+            else if (key == "instruction-fusion") { Process::setFusionEnabled(std::stoi(value) != 0); }
+            else if (key == "instruction-block-lines") { InstructionGenerator::setBlockLines(std::stoi(value)); }
+            else if (key == "program-templates") { Process::setProgramTemplates(std::stoi(value)); }
+            else if (key == "max-finished-processes") { maxFinishedProcesses = std::stoul(value); }
+            else if (key == "seed") { FastRandom::setSeed(std::stoull(value)); }
+            else if (key == "sleep-percent") { InstructionGenerator::setOpcodePercent(ICommand::SLEEP, std::stoi(value)); }
+            else if (key == "print-buffer-lines") { Process::setPrintBufferLines(std::stoi(value)); }
+            else if (key == "print-log") { PrintWriter::getInstance().setEnabled(std::stoi(value) != 0); }
+            else if (key == "alloc-percent") { InstructionGenerator::setOpcodePercent(ICommand::ALLOC, std::stoi(value)); }
+            else if (key == "free-percent") { InstructionGenerator::setOpcodePercent(ICommand::FREE, std::stoi(value)); }
+            else if (key == "heap-max-alloc") { Process::setHeapMaxAlloc(std::stoi(value)); }
+            else if (key == "read-percent") { InstructionGenerator::setOpcodePercent(ICommand::READ, std::stoi(value)); }
+            else if (key == "write-percent") { InstructionGenerator::setOpcodePercent(ICommand::WRITE, std::stoi(value)); }
+            else if (key == "io-percent") { InstructionGenerator::setOpcodePercent(ICommand::IO, std::stoi(value)); }
+            else if (key == "fork-percent") { InstructionGenerator::setOpcodePercent(ICommand::FORK, std::stoi(value)); }
+            else if (key == "max-fork-depth") { Process::setMaxForkDepth(std::stoi(value)); }
+            else if (key == "attach-percent") { InstructionGenerator::setOpcodePercent(ICommand::ATTACH, std::stoi(value)); }
+            else if (key == "detach-percent") { InstructionGenerator::setOpcodePercent(ICommand::DETACH, std::stoi(value)); }
+            else if (key == "send-percent") { InstructionGenerator::setOpcodePercent(ICommand::SEND, std::stoi(value)); }
+            else if (key == "recv-percent") { InstructionGenerator::setOpcodePercent(ICommand::RECV, std::stoi(value)); }
+            else if (key == "channels") { ChannelTable::getInstance().configure(std::stoi(value), ChannelTable::getInstance().getCapacity()); }
+            else if (key == "channel-capacity") { ChannelTable::getInstance().configure(ChannelTable::getInstance().getChannelCount(), std::stoi(value)); }
+            else if (key == "channel-timeout") { ChannelTable::getInstance().setTimeout(std::stoi(value)); }
+            else if (key == "priority-levels") { Process::setPriorityLevels(std::stoi(value)); }
+            else if (key == "priority-inheritance") { SyncTable::getInstance().setPriorityInheritance(std::stoi(value) != 0); }
+            else if (key == "lock-percent") { InstructionGenerator::setOpcodePercent(ICommand::LOCK, std::stoi(value)); }
+            else if (key == "unlock-percent") { InstructionGenerator::setOpcodePercent(ICommand::UNLOCK, std::stoi(value)); }
+            else if (key == "sem-wait-percent") { InstructionGenerator::setOpcodePercent(ICommand::SEM_WAIT, std::stoi(value)); }
+            else if (key == "sem-signal-percent") { InstructionGenerator::setOpcodePercent(ICommand::SEM_SIGNAL, std::stoi(value)); }
+            else if (key == "sync-locks") { SyncTable::getInstance().configure(std::stoi(value), SyncTable::getInstance().getSemaphoreCount(), SyncTable::getInstance().getSemaphoreValue()); }
+            else if (key == "sync-semaphores") { SyncTable::getInstance().configure(SyncTable::getInstance().getLockCount(), std::stoi(value), SyncTable::getInstance().getSemaphoreValue()); }
+            else if (key == "sync-semaphore-count") { SyncTable::getInstance().configure(SyncTable::getInstance().getLockCount(), SyncTable::getInstance().getSemaphoreCount(), std::stoi(value)); }
+            else if (key == "sync-timeout") { SyncTable::getInstance().setTimeout(std::stoi(value)); }
+            else if (key == "load-control") { loadController.setEnabled(std::stoi(value) != 0); }
+            else if (key == "load-control-interval") { loadController.setInterval(std::stoi(value)); }
+            else if (key == "load-control-suspend-rate") { loadController.setSuspendRate(std::stod(value)); }
+            else if (key == "load-control-resume-rate") { loadController.setResumeRate(std::stod(value)); }
+            else if (key == "load-control-min-active") { loadController.setMinActive(std::stoi(value)); }
+            else if (key == "cpu-group"){
+                int quota = 0, period = 100, weight = 100;
+                iss >> quota >> period >> weight;
+                cpuBandwidth.defineGroup(value, quota, period, weight);
+            }
+            else if (key == "cpu-share"){
+                if (!cpuBandwidth.setShareMode(value))
+                    std::cerr << "Warning: Unknown CPU share mode '" << value << "', using " << cpuBandwidth.getShareModeName() << std::endl;
+            }
+            else if (key == "smi-refresh-ms") { UI_Manager::getInstance().setRefreshInterval(std::stoi(value)); }
         }
         else 
             std::cerr << "Warning: Unrecognized parameter in config file: " << key << std::endl;
     }
 
+    SyncTable::getInstance().setPriorityScheduling(schedulerAlgorithm == "priority");
     file.close();
 }
 
-Process* Scheduler::selectRandomProcessToSwapOut(){
-    std::vector<Process*> candidates;
-
-    for (const auto& process : runningProcesses) {
-        if (process != nullptr && process->currentState == Process::RUNNING){
-            candidates.push_back(process.get());
+// A process brought in stays resident until it finishes or is swapped out to make room for another
+bool Scheduler::loadProcess(Process* process){
+    Memory& memory = Memory::getInstance();
+    if (process->getAllocatedMemory())
+        return true;
+
+    bool loaded = memory.allocateMemory(process) != nullptr;
+    while (!loaded){
+        Process* processToSwapOut = selectRandomProcessToSwapOut(process);
+        if (!processToSwapOut)
+            break;
+
+        // Neither frames nor swap left: kill a process, then try again with whatever it gave back.
+        // With nothing worth killing the incoming process waits for memory to free up.
+        if (!swapHasRoom(processToSwapOut, process)){
+            uint32_t victim = selectOomVictim(process);
+            if (victim == ProcessTable::NONE)
+                return false;
+
+            killProcess(victim);
+            loaded = memory.allocateMemory(process) != nullptr;
+            continue;
         }
+
+        swapOutProcess(processToSwapOut, process);
+        loaded = memory.allocateMemory(process) != nullptr;
+        break;
+    }
+
+    if (!loaded)
+        return false;
+
+    if (process->swappedOut){
+        process->swappedOut = false;
+        swapUsedKB -= process->getMemRequired();
     }
 
+    numPagedIn += process->getNumPage();
+    residentProcesses.push_back(process->getSlot());
+    return true;
+}
+
+// The incoming process pays for writing back the victim's dirty pages before it can run
+void Scheduler::swapOutProcess(Process* victim, Process* incoming){
+    incoming->stallTicks += Memory::getInstance().writeBackPages(victim);
+    numPagedOut += victim->getNumPage();
+    victim->swappedOut = true;
+    swapUsedKB += victim->getMemRequired();
+    Memory::getInstance().recordReclaim(victim->getMemoryGroup());
+
+    auto pagingAllocator = dynamic_cast<PagingMemoryAllocator*>(Memory::getInstance().getAllocator());
+    if (pagingAllocator){
+        pagingAllocator->writeProcessToBackingStore(incoming, victim);
+        pagingAllocator->readProcessFromBackingStore(incoming);
+    }
+
+    unloadProcess(victim->getSlot());
+}
+
+void Scheduler::unloadProcess(uint32_t index){
+    auto it = std::find(residentProcesses.begin(), residentProcesses.end(), index);
+    if (it == residentProcesses.end())
+        return;
+
+    *it = residentProcesses.back();
+    residentProcesses.pop_back();
+    Memory::getInstance().deallocateMemory(ProcessTable::getInstance().getProcess(index));
+}
+
+// Any resident process not currently on a core can be swapped out. Processes of groups using more
+// than their reservation go first, and a process held back by its own group's limit can only make
+// room by swapping out another process of that group.
+Process* Scheduler::selectRandomProcessToSwapOut(Process* incoming){
+    Memory& memory = Memory::getInstance();
+    ProcessTable& table = ProcessTable::getInstance();
+    bool atLimit = memory.isGroupAtLimit(incoming);
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> overReserve;
+
+    for (uint32_t index : residentProcesses){
+        if (std::find(runningProcesses.begin(), runningProcesses.end(), index) != runningProcesses.end())
+            continue;
+
+        int group = table.getProcess(index)->getMemoryGroup();
+        if (atLimit && group != incoming->getMemoryGroup())
+            continue;
+
+        candidates.push_back(index);
+        if (memory.isGroupOverReserve(group))
+            overReserve.push_back(index);
+    }
+
+    if (!overReserve.empty())
+        candidates.swap(overReserve);
+
     if (candidates.empty())
         return nullptr;
 
-    size_t randomIndex = std::rand() % candidates.size();
-    
-    return candidates[randomIndex];
+    int randomIndex = FastRandom::local().nextInt(0, static_cast<int>(candidates.size()) - 1);
+
+    return ProcessTable::getInstance().getProcess(candidates[randomIndex]);
+}
+
+// Charges the process against the commit limit. The first process is always admitted, so one
+// larger than the limit cannot wait forever. Called with queueMutex held.
+bool Scheduler::admitProcess(Process* process){
+    size_t limit = Memory::getInstance().getCommitLimit();
+    if (limit > 0 && committedKB > 0 && committedKB + process->getMemRequired() > limit)
+        return false;
+
+    process->committedKB = process->getMemRequired();
+    committedKB += process->committedKB;
+    return true;
+}
+
+void Scheduler::admitPendingProcesses(){
+    ProcessTable& table = ProcessTable::getInstance();
+
+    while (!pendingAdmissions.empty() && admitProcess(table.getProcess(pendingAdmissions.front()))){
+        readyQueue.push_back(pendingAdmissions.front());
+        pendingAdmissions.pop_front();
+    }
+}
+
+void Scheduler::releaseCommit(Process* process){
+    {
+        std::lock_guard<std::mutex> lock(process->mutex);
+        committedKB -= process->committedKB;
+        process->committedKB = 0;
+    }
+
+    if (process->swappedOut){
+        process->swappedOut = false;
+        swapUsedKB -= process->getMemRequired();
+    }
+}
+
+bool Scheduler::commitGrowth(Process* process, size_t kb){
+    size_t limit = Memory::getInstance().getCommitLimit();
+    size_t committed = committedKB.load();
+
+    do{
+        if (limit > 0 && committed + kb > limit)
+            return false;
+    } while (!committedKB.compare_exchange_weak(committed, committed + kb));
+
+    process->committedKB += kb;
+    return true;
+}
+
+void Scheduler::releaseGrowth(Process* process, size_t kb){
+    kb = std::min(kb, process->committedKB);
+    committedKB -= kb;
+    process->committedKB -= kb;
+}
+
+// Whether swapping the victim out fits in swap, counting the slots the incoming process frees
+// when it is read back in
+bool Scheduler::swapHasRoom(Process* victim, Process* incoming) const{
+    size_t swapKB = Memory::getInstance().getSwapSize();
+    if (swapKB == 0)
+        return true;
+
+    size_t used = swapUsedKB;
+    if (incoming && incoming->swappedOut)
+        used -= incoming->getMemRequired();
+
+    return used + victim->getMemRequired() <= swapKB;
+}
+
+// Scored by the memory a kill gives back: the frames only the process maps, or the swap it
+// holds. Less urgent priorities and younger processes score higher, so a kill frees as much as
+// possible while throwing away as little work as possible.
+double Scheduler::oomBadness(Process* process) const{
+    size_t heldKB = process->swappedOut ? process->getMemRequired() : Memory::getInstance().getResidentKB(process);
+    double urgency = 1.0 + static_cast<double>(process->getPriority()) / Process::getPriorityLevels();
+    double ageSeconds = static_cast<double>(currentTick() - std::min(currentTick(), process->arrivalTick)) / 1000.0;
+
+    return heldKB * urgency * (1.0 + 1.0 / (1.0 + ageSeconds));
+}
+
+// Candidates are the processes in the ready or suspended queue that hold frames or swap, so every
+// kill gives something back; only the incoming process's group when that group's limit holds it
+// back. Processes on a core, asleep or blocked are never picked, nor is the incoming process.
+// Returns ProcessTable::NONE when no process would give anything back.
+uint32_t Scheduler::selectOomVictim(Process* incoming){
+    ProcessTable& table = ProcessTable::getInstance();
+    bool atLimit = Memory::getInstance().isGroupAtLimit(incoming);
+    uint32_t victim = ProcessTable::NONE;
+    double highest = 0.0;
+
+    for (const std::deque<uint32_t>* queue : { &readyQueue, &suspendedProcesses }){
+        for (uint32_t index : *queue){
+            Process* process = table.getProcess(index);
+            if (process == incoming || (!process->getAllocatedMemory() && !process->swappedOut))
+                continue;
+            if (atLimit && process->getMemoryGroup() != incoming->getMemoryGroup())
+                continue;
+
+            double badness = oomBadness(process);
+            if (badness > highest){
+                victim = index;
+                highest = badness;
+            }
+        }
+    }
+
+    return victim;
+}
+
+// Ends a process without running it to completion, giving back its frames, swap and commit
+void Scheduler::killProcess(uint32_t index){
+    Process* process = ProcessTable::getInstance().getProcess(index);
+
+    auto it = std::find(readyQueue.begin(), readyQueue.end(), index);
+    if (it != readyQueue.end())
+        readyQueue.erase(it);
+    it = std::find(suspendedProcesses.begin(), suspendedProcesses.end(), index);
+    if (it != suspendedProcesses.end())
+        suspendedProcesses.erase(it);
+
+    oomKills.push_back({ process->getName(), UI_Manager::getInstance().generateTimestamp(), process->getMemRequired(), oomBadness(process) });
+
+    ChannelTable::getInstance().release(index);
+    SyncTable::getInstance().release(index);
+    unloadProcess(index);
+    releaseCommit(process);
+
+    process->oomKilled = true;
+    process->setProcessState(Process::FINISHED);
+    retireProcess(index);
 }
 
 void Scheduler::generateQuantumCycleTxtFile(int quantumCycle){
@@ -368,11 +951,12 @@ int Scheduler::getMaxPage() const {
 
 std::vector<std::shared_ptr<Process>> Scheduler::getRunningProcesses(){
     std::lock_guard<std::mutex> lock(queueMutex);
+    ProcessTable& table = ProcessTable::getInstance();
     std::vector<std::shared_ptr<Process>> running;
 
-    for (const auto& process : runningProcesses){
-        if (process != nullptr && process->currentState == Process::RUNNING){
-            running.push_back(process);
+    for (uint32_t index : runningProcesses){
+        if (index != ProcessTable::NONE && table.state(index) == Process::RUNNING){
+            running.push_back(table.getSharedProcess(index));
         }
     }
 
@@ -380,14 +964,90 @@ std::vector<std::shared_ptr<Process>> Scheduler::getRunningProcesses(){
 }
 
 std::vector<std::shared_ptr<Process>> Scheduler::getFinishedProcesses() const{
-    return finishedProcesses;
+    std::lock_guard<std::mutex> lock(queueMutex);
+    ProcessTable& table = ProcessTable::getInstance();
+    std::vector<std::shared_ptr<Process>> finished;
+
+    for (uint32_t index : finishedProcesses)
+        finished.push_back(table.getSharedProcess(index));
+
+    return finished;
+}
+
+size_t Scheduler::getSleepQueueDepth() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return sleepQueue.size();
+}
+
+CpuBandwidth& Scheduler::getCpuBandwidth(){
+    return cpuBandwidth;
+}
+
+void Scheduler::printCpuStatistics() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    cpuBandwidth.printStatistics(currentMicroseconds());
+}
+
+size_t Scheduler::getPendingAdmissions() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return pendingAdmissions.size();
+}
+
+size_t Scheduler::getCommittedMemory() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return committedKB;
+}
+
+size_t Scheduler::getSwapUsed() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return swapUsedKB;
+}
+
+std::vector<Scheduler::OomKill> Scheduler::getOomKills() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return oomKills;
+}
+
+size_t Scheduler::getSuspendedCount() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return suspendedProcesses.size();
+}
+
+double Scheduler::getFaultRate() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return loadController.getFaultRate();
+}
+
+void Scheduler::printLoadHistory() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    loadController.printHistory();
+}
+
+double Scheduler::getAverageWakeupLateness() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return sleepQueue.getAverageLateness();
+}
+
+uint64_t Scheduler::getMaxWakeupLateness() const{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return sleepQueue.getMaxLateness();
 }
 
 void Scheduler::shutdown(){
-    running = false;
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        running = false;
+        threads = std::move(coreThreads);
+    }
+
+    coreCV.notify_all();
     processCV.notify_all(); // Notify all threads to wake up
-    for (auto& thread : coreThreads){
+    for (auto& thread : threads){
         if (thread.joinable())
             thread.join();
     }
+
+    PrintWriter::getInstance().stop();
+    PageMerger::getInstance().stop();
 }
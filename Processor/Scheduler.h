@@ -8,16 +8,23 @@
 #include <sstream>
 #include <stdexcept>
 #include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <iomanip>
 #include <condition_variable>
 
 #include "Process.h"
+#include "ProcessTable.h"
+#include "TimerWheel.h"
+#include "LoadController.h"
+#include "CpuBandwidth.h"
 #include "../Memory/Memory.h"
 #include "../UI/UI_Manager.h"
+#include "../Resource/ResourceEmulator.h"
 
 class Scheduler{
 public:
@@ -25,6 +32,14 @@ public:
     static void initialize();
     static void destroy();
     void addProcess(std::shared_ptr<Process> process);
+    void addProcesses(const std::vector<std::shared_ptr<Process>> &processes);
+    std::shared_ptr<Process> createProcess(int pid, const std::string &name);
+    std::shared_ptr<Process> forkProcess(Process* parent, int pid, const std::string &name);
+    // Forks a parent that is not on a core, for the console; nullptr while the parent is running
+    std::shared_ptr<Process> forkIdleProcess(Process* parent, int pid, const std::string &name);
+    // Queues a child made by forkProcess, sharing the parent's memory if the parent is in memory
+    void addForkedProcess(std::shared_ptr<Process> child, Process* parent);
+    std::vector<std::shared_ptr<Process>> generateProcesses(int count);
     void run();
     void shutdown();
     std::condition_variable processCV;
@@ -39,6 +54,29 @@ public:
     int getMaxPage() const;
     std::vector<std::shared_ptr<Process>> getRunningProcesses();
     std::vector<std::shared_ptr<Process>> getFinishedProcesses() const;
+    size_t getSleepQueueDepth() const;
+    double getAverageWakeupLateness() const;
+    uint64_t getMaxWakeupLateness() const;
+    size_t getSuspendedCount() const;
+    double getFaultRate() const;
+    void printLoadHistory() const;
+    CpuBandwidth& getCpuBandwidth();
+    void printCpuStatistics() const;
+
+    struct OomKill{
+        std::string name;
+        std::string timestamp;
+        size_t memoryKB;
+        double badness;
+    };
+    size_t getPendingAdmissions() const;
+    // Heap growth of a running process against the commit limit. Called from the core running it,
+    // with the process's mutex held.
+    bool commitGrowth(Process* process, size_t kb);
+    void releaseGrowth(Process* process, size_t kb);
+    size_t getCommittedMemory() const;
+    size_t getSwapUsed() const;
+    std::vector<OomKill> getOomKills() const;
 
     void setMemory(Memory& mem);
 
@@ -47,9 +85,10 @@ public:
 
     int numPagedIn;
     int numPagedOut;
+    int numForks;
     int activeCPUTicks;
     int idleCPUTicks;
-    static int qqCounter;
+    static std::atomic<int> qqCounter;
     void generateQuantumCycleTxtFile(int quantumCycle);
 
 private:
@@ -68,21 +107,70 @@ private:
     double delaysPerExecution;
 
     void firstComeFirstServe();
-    void roundRobin(int quantumCycles);
+    void roundRobin();
+    void startCores();
+    void coreWorker(int coreID);
+    uint32_t popReadyProcess();
 
-    std::queue<std::shared_ptr<Process>> readyQueue;
+    // Slot indices into ProcessTable
+    std::deque<uint32_t> readyQueue;
     std::vector<std::thread> coreThreads;
-    std::vector<std::shared_ptr<Process>> runningProcesses;
-    std::vector<std::shared_ptr<Process>> finishedProcesses;
+    std::vector<uint32_t> runningProcesses;
+    std::deque<uint32_t> finishedProcesses;
+    size_t maxFinishedProcesses;
+
+    void retireProcess(uint32_t index);
+
+    // Sleeping processes park here off-core; one tick is one millisecond since the scheduler started
+    TimerWheel sleepQueue;
+    std::vector<uint32_t> wokenProcesses;
+    std::chrono::steady_clock::time_point startTime;
+
+    uint64_t currentTick() const;
+    uint64_t currentMicroseconds() const;
+    int idleDelay() const;
+    void wakeProcesses();
+
+    // Thrashing control: processes suspended to lower the multiprogramming level, oldest first
+    LoadController loadController;
+    std::deque<uint32_t> suspendedProcesses;
+    void controlLoad();
+    void suspendProcess();
+    void resumeProcess();
+
+    // CPU group quotas and proportional share, consulted by popReadyProcess
+    CpuBandwidth cpuBandwidth;
 
     std::mutex processMutex;
     mutable std::mutex queueMutex;
+    std::condition_variable coreCV;
     
     int numCores;
     bool running;
-    bool createProcess;
 
-    Process* selectRandomProcessToSwapOut();
+    // Slots of the processes holding memory; guarded by queueMutex
+    std::vector<uint32_t> residentProcesses;
+
+    bool loadProcess(Process* process);
+    void swapOutProcess(Process* victim, Process* incoming);
+    void unloadProcess(uint32_t index);
+    Process* selectRandomProcessToSwapOut(Process* incoming);
+
+    // Overcommit: processes are admitted to the ready queue while the memory they were created with
+    // fits under the commit limit, and the rest wait here in arrival order
+    std::deque<uint32_t> pendingAdmissions;
+    // Atomic so heap growth can be committed from a core without queueMutex
+    std::atomic<size_t> committedKB{0};
+    size_t swapUsedKB = 0;
+    std::vector<OomKill> oomKills;
+
+    bool admitProcess(Process* process);
+    void admitPendingProcesses();
+    void releaseCommit(Process* process);
+    bool swapHasRoom(Process* victim, Process* incoming) const;
+    double oomBadness(Process* process) const;
+    uint32_t selectOomVictim(Process* incoming);
+    void killProcess(uint32_t index);
 
     Memory* memory;
     static Scheduler* sharedInstance;
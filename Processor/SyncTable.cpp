@@ -0,0 +1,369 @@
+#include <iostream>
+#include <algorithm>
+
+#include "SyncTable.h"
+#include "Process.h"
+#include "ProcessTable.h"
+
+SyncTable* SyncTable::sharedInstance = nullptr;
+
+SyncTable& SyncTable::getInstance(){
+    if (!sharedInstance)
+        initialize();
+
+    return *sharedInstance;
+}
+
+void SyncTable::initialize(){
+    if (!sharedInstance)
+        sharedInstance = new SyncTable();
+}
+
+void SyncTable::destroy(){
+    if (sharedInstance){
+        delete sharedInstance;
+        sharedInstance = nullptr;
+    }
+}
+
+SyncTable::SyncTable() : semaphoreCount(2), timeout(1000), priorityInheritance(true), priorityScheduling(false),
+    startTime(std::chrono::steady_clock::now()), parked(0), inheritanceBoosts(0), deadlocksRefused(0){
+    configure(4, 4, semaphoreCount);
+}
+
+void SyncTable::configure(int locks, int semaphores, int semaphoreCount){
+    std::lock_guard<std::mutex> lock(mutex);
+    this->semaphoreCount = std::max(1, semaphoreCount);
+    this->locks.assign(std::max(1, locks), SyncObject());
+    this->semaphores.assign(std::max(1, semaphores), SyncObject());
+
+    for (SyncObject &semaphore : this->semaphores){
+        semaphore.kind = SEMAPHORE;
+        semaphore.count = this->semaphoreCount;
+    }
+}
+
+void SyncTable::setTimeout(int milliseconds){
+    std::lock_guard<std::mutex> lock(mutex);
+    timeout = std::max(0, milliseconds);
+}
+
+void SyncTable::setPriorityInheritance(bool enabled){
+    std::lock_guard<std::mutex> lock(mutex);
+    priorityInheritance = enabled;
+}
+
+void SyncTable::setPriorityScheduling(bool enabled){
+    std::lock_guard<std::mutex> lock(mutex);
+    priorityScheduling = enabled;
+}
+
+int SyncTable::getLockCount() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(locks.size());
+}
+
+int SyncTable::getSemaphoreCount() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(semaphores.size());
+}
+
+int SyncTable::getSemaphoreValue() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return semaphoreCount;
+}
+
+int SyncTable::getTimeout() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return timeout;
+}
+
+bool SyncTable::isPriorityInheritanceActive() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return priorityScheduling && priorityInheritance;
+}
+
+SyncTable::SyncObject& SyncTable::getObject(Kind kind, uint16_t operand){
+    std::vector<SyncObject> &objects = kind == MUTEX ? locks : semaphores;
+    return objects[operand % objects.size()];
+}
+
+bool SyncTable::lock(Process* process, uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    SyncObject &object = getObject(MUTEX, operand);
+    uint32_t slot = process->getSlot();
+
+    if (object.owner != slot)
+        ++object.attempts;
+    if (object.owner == NONE)
+        acquire(object, slot, currentMicroseconds());
+
+    // LOCK on a lock the process already holds does nothing
+    return object.owner == slot;
+}
+
+// UNLOCK of a lock held by another process, or by nobody, is ignored
+void SyncTable::unlock(Process* process, uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    SyncObject &object = getObject(MUTEX, operand);
+
+    if (object.owner == process->getSlot())
+        releaseLock(object, currentMicroseconds());
+}
+
+bool SyncTable::wait(Process* process, uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    SyncObject &object = getObject(SEMAPHORE, operand);
+    ++object.attempts;
+
+    if (object.count == 0)
+        return false;
+
+    acquire(object, process->getSlot(), currentMicroseconds());
+    return true;
+}
+
+// Any process may signal. The count never goes above sync-semaphore-count, so stray signals
+// cannot build up credit.
+void SyncTable::signal([[maybe_unused]] Process* process, uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    SyncObject &object = getObject(SEMAPHORE, operand);
+
+    if (object.count < semaphoreCount)
+        ++object.count;
+    if (!object.waiters.empty())
+        handOff(object, currentMicroseconds());
+}
+
+bool SyncTable::park(uint32_t slot, Kind kind, uint16_t operand){
+    std::lock_guard<std::mutex> lock(mutex);
+    SyncObject &object = getObject(kind, operand);
+    uint64_t now = currentMicroseconds();
+
+    // Released between the failed attempt and here
+    if (kind == MUTEX ? object.owner == NONE : object.count > 0){
+        acquire(object, slot, now);
+        return false;
+    }
+
+    if (kind == MUTEX){
+        // Following owners through the locks they wait on must not lead back to this process
+        uint32_t owner = object.owner;
+        for (size_t hops = 0; owner != NONE && hops <= locks.size(); ++hops){
+            if (owner == slot){
+                ++deadlocksRefused;
+                return false;
+            }
+
+            auto it = waitingOn.find(owner);
+            if (it == waitingOn.end())
+                break;
+            owner = locks[it->second].owner;
+        }
+
+        waitingOn[slot] = static_cast<int>(operand % locks.size());
+    }
+
+    object.waiters.push_back({ slot, now });
+    ++object.contended;
+    object.maxWaiters = std::max(object.maxWaiters, object.waiters.size());
+    ++parked;
+
+    if (kind == MUTEX)
+        updatePriority(object.owner);
+    return true;
+}
+
+void SyncTable::advance(std::vector<uint32_t> &woken){
+    std::lock_guard<std::mutex> lock(mutex);
+    if (parked == 0)
+        return;
+
+    // Waits that ran past sync-timeout end without the object
+    if (timeout > 0){
+        uint64_t now = currentMicroseconds();
+        uint64_t limit = static_cast<uint64_t>(timeout) * 1000;
+
+        for (std::vector<SyncObject>* objects : { &locks, &semaphores }){
+            for (SyncObject &object : *objects){
+                size_t before = object.waiters.size();
+
+                for (auto it = object.waiters.begin(); it != object.waiters.end(); ){
+                    if (now - it->parkedAt < limit){
+                        ++it;
+                        continue;
+                    }
+
+                    object.waitTimes.record(now - it->parkedAt);
+                    ++object.timeouts;
+                    waitingOn.erase(it->slot);
+                    pending.push_back(it->slot);
+                    it = object.waiters.erase(it);
+                }
+
+                if (object.kind == MUTEX && object.waiters.size() != before)
+                    updatePriority(object.owner);
+            }
+        }
+    }
+
+    woken.insert(woken.end(), pending.begin(), pending.end());
+    parked -= pending.size();
+    pending.clear();
+}
+
+void SyncTable::release(uint32_t slot){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (SyncObject &object : locks){
+        if (object.owner == slot)
+            releaseLock(object, currentMicroseconds());
+    }
+}
+
+size_t SyncTable::getParkedProcesses() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return parked;
+}
+
+// The helpers below are called with mutex held
+
+void SyncTable::acquire(SyncObject &object, uint32_t slot, uint64_t now){
+    if (object.kind == MUTEX)
+        object.owner = slot;
+    else
+        --object.count;
+
+    object.acquiredAt = now;
+    ++object.acquisitions;
+}
+
+// Gives the object to the next waiter: the first one, or under the priority scheduler the most
+// urgent one
+void SyncTable::handOff(SyncObject &object, uint64_t now){
+    auto next = object.waiters.begin();
+    if (priorityScheduling){
+        next = std::min_element(object.waiters.begin(), object.waiters.end(), [this](const Waiter &a, const Waiter &b){
+            return getEffectivePriority(a.slot) < getEffectivePriority(b.slot);
+        });
+    }
+
+    Waiter waiter = *next;
+    object.waiters.erase(next);
+    object.waitTimes.record(now - waiter.parkedAt);
+    waitingOn.erase(waiter.slot);
+    acquire(object, waiter.slot, now);
+    pending.push_back(waiter.slot);
+
+    if (object.kind == MUTEX)
+        updatePriority(waiter.slot);
+}
+
+void SyncTable::releaseLock(SyncObject &object, uint64_t now){
+    uint32_t previous = object.owner;
+    object.holdTimes.record(now - object.acquiredAt);
+    object.owner = NONE;
+
+    if (!object.waiters.empty())
+        handOff(object, now);
+
+    // Whatever the previous owner inherited through this lock is given back
+    updatePriority(previous);
+}
+
+// A lock owner runs at the most urgent of its own priority and those of the processes waiting on
+// its locks. A change is passed on to the owner of the lock this process itself waits on.
+void SyncTable::updatePriority(uint32_t slot){
+    if (!priorityScheduling || !priorityInheritance)
+        return;
+
+    ProcessTable& table = ProcessTable::getInstance();
+    for (size_t hops = 0; slot != NONE && hops <= locks.size(); ++hops){
+        Process* process = table.getProcess(slot);
+        if (!process)
+            return;
+
+        int priority = process->getPriority();
+        for (const SyncObject &object : locks){
+            if (object.owner != slot)
+                continue;
+
+            for (const Waiter &waiter : object.waiters)
+                priority = std::min(priority, getEffectivePriority(waiter.slot));
+        }
+
+        int previous = process->effectivePriority().exchange(static_cast<int16_t>(priority));
+        if (priority == previous)
+            return;
+        if (priority < previous)
+            ++inheritanceBoosts;
+
+        auto it = waitingOn.find(slot);
+        if (it == waitingOn.end())
+            return;
+        slot = locks[it->second].owner;
+    }
+}
+
+int SyncTable::getEffectivePriority(uint32_t slot) const{
+    Process* process = ProcessTable::getInstance().getProcess(slot);
+    return process ? process->getEffectivePriority() : 0;
+}
+
+uint64_t SyncTable::currentMicroseconds() const{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void SyncTable::Histogram::record(uint64_t microseconds){
+    int bucket = 0;
+    for (uint64_t limit = 10; bucket < HISTOGRAM_BUCKETS - 1 && microseconds >= limit; limit *= 10)
+        ++bucket;
+
+    ++buckets[bucket];
+    ++count;
+    total += microseconds;
+}
+
+void SyncTable::Histogram::print(const char* label) const{
+    static const char* names[HISTOGRAM_BUCKETS] = { "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s" };
+
+    std::cout << "      " << label << (count > 0 ? total / 1000.0 / count : 0.0) << " ms avg |";
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket)
+        std::cout << " " << names[bucket] << ":" << buckets[bucket];
+    std::cout << std::endl;
+}
+
+void SyncTable::printStatistics() const{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|             SYNC STATISTICS            |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << " Locks: " << locks.size() << ", Semaphores: " << semaphores.size() << " (count " << semaphoreCount
+              << "), timeout " << timeout << " ms" << std::endl;
+    std::cout << " Priority Inheritance: " << (priorityScheduling && priorityInheritance ? "On" : "Off") << std::endl;
+
+    for (std::vector<SyncObject> const* objects : { &locks, &semaphores }){
+        for (size_t i = 0; i < objects->size(); ++i){
+            const SyncObject &object = (*objects)[i];
+
+            std::cout << std::endl;
+            std::cout << " " << (object.kind == MUTEX ? "Lock " : "Semaphore ") << i << std::endl;
+            std::cout << "      Acquisitions:           " << object.acquisitions << " of " << object.attempts << " attempts" << std::endl;
+            std::cout << "      Contended:              " << object.contended << " ("
+                      << (object.attempts > 0 ? 100.0 * object.contended / object.attempts : 0.0) << "%)" << std::endl;
+            std::cout << "      Waiting Now:            " << object.waiters.size() << " (max " << object.maxWaiters << ")" << std::endl;
+            std::cout << "      Timed Out Waits:        " << object.timeouts << std::endl;
+            if (object.kind == MUTEX)
+                object.holdTimes.print("Hold Time:              ");
+            object.waitTimes.print("Wait Time:              ");
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << "      Inheritance Boosts:     " << inheritanceBoosts << std::endl;
+    std::cout << "      Deadlocks Refused:      " << deadlocksRefused << std::endl;
+    std::cout << "      Parked Processes:       " << parked << std::endl;
+    std::cout << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#ifndef SYNC_TABLE_H
+#define SYNC_TABLE_H
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+
+class Process;
+
+// Emulated mutexes for LOCK/UNLOCK and counting semaphores for SEM_WAIT/SEM_SIGNAL. A process that
+// cannot acquire one gives up its core and is parked in the object's wait queue; a release hands
+// the object straight to the next waiter, so a busy lock forms a convoy like a real one. Under the
+// priority scheduler the next waiter is the most urgent one, and a lock owner inherits the priority
+// of its most urgent waiter. Waits end unsuccessfully after sync-timeout, and a LOCK that would
+// close a cycle of waiting owners is refused instead of deadlocking.
+class SyncTable{
+public:
+    enum Kind
+    {
+        MUTEX,
+        SEMAPHORE
+    };
+
+    static SyncTable& getInstance();
+    static void initialize();
+    static void destroy();
+
+    // Only called while reading the config, before any process runs
+    void configure(int locks, int semaphores, int semaphoreCount);
+    void setTimeout(int milliseconds);
+    void setPriorityInheritance(bool enabled);
+    void setPriorityScheduling(bool enabled);
+    int getLockCount() const;
+    int getSemaphoreCount() const;
+    int getSemaphoreValue() const;
+    int getTimeout() const;
+    bool isPriorityInheritanceActive() const;
+
+    // Run on the process's core. False when the process has to be parked once it yields.
+    bool lock(Process* process, uint16_t operand);
+    void unlock(Process* process, uint16_t operand);
+    bool wait(Process* process, uint16_t operand);
+    void signal(Process* process, uint16_t operand);
+
+    // Called with the scheduler's queueMutex held. park() is false if the process got the object
+    // while yielding, or was refused it, and goes straight back to the ready queue.
+    bool park(uint32_t slot, Kind kind, uint16_t operand);
+    void advance(std::vector<uint32_t> &woken);
+    // Releases the locks of a finished process
+    void release(uint32_t slot);
+    size_t getParkedProcesses() const;
+
+    void printStatistics() const;
+
+private:
+    SyncTable();
+    SyncTable(const SyncTable&) = delete;
+    SyncTable& operator=(const SyncTable&) = delete;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+    // Decades of microseconds: under 10us, 100us, 1ms, 10ms, 100ms, 1s, and the rest
+    static constexpr int HISTOGRAM_BUCKETS = 7;
+
+    struct Histogram{
+        uint64_t buckets[HISTOGRAM_BUCKETS] = {};
+        uint64_t count = 0;
+        uint64_t total = 0;
+
+        void record(uint64_t microseconds);
+        void print(const char* label) const;
+    };
+
+    struct Waiter{
+        uint32_t slot;
+        uint64_t parkedAt;
+    };
+
+    struct SyncObject{
+        Kind kind = MUTEX;
+        // Mutexes have an owner, semaphores a count
+        uint32_t owner = NONE;
+        int count = 0;
+        uint64_t acquiredAt = 0;
+        std::deque<Waiter> waiters;
+
+        uint64_t attempts = 0;
+        uint64_t acquisitions = 0;
+        uint64_t contended = 0;
+        uint64_t timeouts = 0;
+        size_t maxWaiters = 0;
+        Histogram holdTimes;
+        Histogram waitTimes;
+    };
+
+    SyncObject& getObject(Kind kind, uint16_t operand);
+    void acquire(SyncObject &object, uint32_t slot, uint64_t now);
+    void handOff(SyncObject &object, uint64_t now);
+    void releaseLock(SyncObject &object, uint64_t now);
+    void updatePriority(uint32_t slot);
+    int getEffectivePriority(uint32_t slot) const;
+    uint64_t currentMicroseconds() const;
+
+    std::vector<SyncObject> locks;
+    std::vector<SyncObject> semaphores;
+    int semaphoreCount;
+    int timeout;
+    bool priorityInheritance;
+    bool priorityScheduling;
+    std::chrono::steady_clock::time_point startTime;
+
+    // Lock each parked LOCK is waiting on, for inheritance chains and cycle checks
+    std::unordered_map<uint32_t, int> waitingOn;
+    // Processes whose wait ended, handed to the scheduler by advance()
+    std::vector<uint32_t> pending;
+    size_t parked;
+
+    uint64_t inheritanceBoosts;
+    uint64_t deadlocksRefused;
+
+    mutable std::mutex mutex;
+    static SyncTable* sharedInstance;
+};
+
+#endif
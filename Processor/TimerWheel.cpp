@@ -0,0 +1,140 @@
+#include <algorithm>
+
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel() : currentTick(0), count(0), firedCount(0), totalLateness(0), maxLateness(0){
+    std::fill(buckets, buckets + LEVELS * SLOTS, NONE);
+}
+
+void TimerWheel::schedule(uint32_t id, uint64_t dueTick){
+    if (id >= nodes.size())
+        nodes.resize(id + 1);
+
+    if (nodes[id].armed)
+        unlink(id);
+
+    nodes[id].due = dueTick;
+
+    // The current tick has already been processed, so the earliest a new timer can fire is the next one
+    insert(id, std::max(dueTick, currentTick + 1));
+}
+
+bool TimerWheel::cancel(uint32_t id){
+    if (!isScheduled(id))
+        return false;
+
+    unlink(id);
+    return true;
+}
+
+bool TimerWheel::isScheduled(uint32_t id) const{
+    return id < nodes.size() && nodes[id].armed;
+}
+
+void TimerWheel::advance(uint64_t now, std::vector<uint32_t> &expired){
+    while (currentTick < now){
+        // Nothing to fire, so there is no need to turn the wheel tick by tick
+        if (count == 0){
+            currentTick = now;
+            break;
+        }
+
+        uint64_t tick = ++currentTick;
+
+        // Whenever a level wraps, the next bucket of the level above is redistributed downwards
+        if ((tick & SLOT_MASK) == 0){
+            int top = 1;
+            while (top < LEVELS - 1 && ((tick >> (SLOT_BITS * top)) & SLOT_MASK) == 0)
+                ++top;
+
+            for (int level = top; level >= 1; --level)
+                cascade(level, static_cast<uint32_t>((tick >> (SLOT_BITS * level)) & SLOT_MASK));
+        }
+
+        uint32_t &head = buckets[tick & SLOT_MASK];
+        while (head != NONE){
+            uint32_t id = head;
+            unlink(id);
+            expired.push_back(id);
+
+            uint64_t lateness = now - nodes[id].due;
+            ++firedCount;
+            totalLateness += lateness;
+            maxLateness = std::max(maxLateness, lateness);
+        }
+    }
+}
+
+void TimerWheel::insert(uint32_t id, uint64_t target){
+    uint64_t delta = target - currentTick;
+    int level = 0;
+
+    while (level < LEVELS - 1 && delta >= (1ULL << (SLOT_BITS * (level + 1))))
+        ++level;
+
+    // Anything past the top level's span waits in its last bucket and is cascaded again later
+    uint64_t limit = 1ULL << (SLOT_BITS * LEVELS);
+    if (delta >= limit)
+        target = currentTick + limit - 1;
+
+    uint32_t bucket = level * SLOTS + static_cast<uint32_t>((target >> (SLOT_BITS * level)) & SLOT_MASK);
+    Node &node = nodes[id];
+
+    node.prev = NONE;
+    node.next = buckets[bucket];
+    node.bucket = static_cast<uint16_t>(bucket);
+    node.armed = true;
+
+    if (node.next != NONE)
+        nodes[node.next].prev = id;
+    buckets[bucket] = id;
+    ++count;
+}
+
+void TimerWheel::unlink(uint32_t id){
+    Node &node = nodes[id];
+
+    if (node.prev != NONE)
+        nodes[node.prev].next = node.next;
+    else
+        buckets[node.bucket] = node.next;
+
+    if (node.next != NONE)
+        nodes[node.next].prev = node.prev;
+
+    node.prev = NONE;
+    node.next = NONE;
+    node.armed = false;
+    --count;
+}
+
+void TimerWheel::cascade(int level, uint32_t slot){
+    uint32_t id = buckets[level * SLOTS + slot];
+
+    while (id != NONE){
+        uint32_t next = nodes[id].next;
+        unlink(id);
+        insert(id, std::max(nodes[id].due, currentTick));
+        id = next;
+    }
+}
+
+size_t TimerWheel::size() const{
+    return count;
+}
+
+uint64_t TimerWheel::getCurrentTick() const{
+    return currentTick;
+}
+
+uint64_t TimerWheel::getFiredCount() const{
+    return firedCount;
+}
+
+double TimerWheel::getAverageLateness() const{
+    return firedCount ? static_cast<double>(totalLateness) / firedCount : 0.0;
+}
+
+uint64_t TimerWheel::getMaxLateness() const{
+    return maxLateness;
+}
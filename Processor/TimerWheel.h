@@ -0,0 +1,58 @@
+#pragma once
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Hierarchical timing wheel keyed by ProcessTable slot. Each level has 256 buckets covering 256x
+// the span of the level below; timers are cascaded down as the wheel turns, so scheduling and
+// cancelling are O(1) and advancing costs O(1) per tick plus the timers that fire.
+class TimerWheel{
+public:
+    TimerWheel();
+
+    void schedule(uint32_t id, uint64_t dueTick);
+    bool cancel(uint32_t id);
+    bool isScheduled(uint32_t id) const;
+
+    // Turns the wheel up to now and appends the ids of every timer that came due
+    void advance(uint64_t now, std::vector<uint32_t> &expired);
+
+    size_t size() const;
+    uint64_t getCurrentTick() const;
+    uint64_t getFiredCount() const;
+    double getAverageLateness() const;
+    uint64_t getMaxLateness() const;
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+    struct Node{
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint64_t due = 0;
+        uint16_t bucket = 0;
+        bool armed = false;
+    };
+
+    void insert(uint32_t id, uint64_t target);
+    void unlink(uint32_t id);
+    void cascade(int level, uint32_t slot);
+
+    std::vector<Node> nodes;
+    uint32_t buckets[LEVELS * SLOTS];
+    uint64_t currentTick;
+    size_t count;
+
+    uint64_t firedCount;
+    uint64_t totalLateness;
+    uint64_t maxLateness;
+};
+
+#endif
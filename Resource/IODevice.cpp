@@ -0,0 +1,41 @@
+#include "IODevice.h"
+
+DiskDevice::DiskDevice(uint32_t tracks, uint64_t seekPerTrack, uint64_t transferTime)
+    : tracks(tracks > 0 ? tracks : 1), seekPerTrack(seekPerTrack), transferTime(transferTime), head(0) {}
+
+uint64_t DiskDevice::service(const IORequest &request){
+    uint32_t distance = request.position > head ? request.position - head : head - request.position;
+    head = request.position;
+
+    return distance * seekPerTrack + transferTime;
+}
+
+uint32_t DiskDevice::locate(uint32_t block) const{
+    return block % tracks;
+}
+
+uint32_t DiskDevice::getPosition() const{
+    return head;
+}
+
+std::string DiskDevice::getName() const{
+    return "Disk";
+}
+
+FixedLatencyDevice::FixedLatencyDevice(uint64_t latency) : latency(latency) {}
+
+uint64_t FixedLatencyDevice::service([[maybe_unused]] const IORequest &request){
+    return latency;
+}
+
+uint32_t FixedLatencyDevice::locate([[maybe_unused]] uint32_t block) const{
+    return 0;
+}
+
+uint32_t FixedLatencyDevice::getPosition() const{
+    return 0;
+}
+
+std::string FixedLatencyDevice::getName() const{
+    return "Device";
+}
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef IO_DEVICE_H
+#define IO_DEVICE_H
+
+#include <cstdint>
+#include <string>
+
+// One outstanding IO instruction. Times are in microseconds of scheduler time.
+struct IORequest{
+    uint32_t process;
+    uint32_t block;
+    uint32_t position;
+    uint64_t submitTime;
+    uint64_t deadline;
+    uint64_t sequence;
+};
+
+class IIODevice{
+public:
+    virtual ~IIODevice() = default;
+
+    // Time taken to service the request; moves the device to wherever the request left it
+    virtual uint64_t service(const IORequest &request) = 0;
+
+    // Where a block lives on the device and where the device currently is, for seek-aware schedulers
+    virtual uint32_t locate(uint32_t block) const = 0;
+    virtual uint32_t getPosition() const = 0;
+
+    virtual std::string getName() const = 0;
+};
+
+// Disk with a moving head: cost is a seek proportional to the track distance plus a transfer
+class DiskDevice : public IIODevice{
+public:
+    DiskDevice(uint32_t tracks, uint64_t seekPerTrack, uint64_t transferTime);
+
+    uint64_t service(const IORequest &request) override;
+    uint32_t locate(uint32_t block) const override;
+    uint32_t getPosition() const override;
+    std::string getName() const override;
+
+private:
+    uint32_t tracks;
+    uint64_t seekPerTrack;
+    uint64_t transferTime;
+    uint32_t head;
+};
+
+// Device whose every request takes the same time, e.g. a network card or a terminal
+class FixedLatencyDevice : public IIODevice{
+public:
+    explicit FixedLatencyDevice(uint64_t latency);
+
+    uint64_t service(const IORequest &request) override;
+    uint32_t locate(uint32_t block) const override;
+    uint32_t getPosition() const override;
+    std::string getName() const override;
+
+private:
+    uint64_t latency;
+};
+
+#endif
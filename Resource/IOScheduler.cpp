@@ -0,0 +1,94 @@
+#include <iterator>
+
+#include "IOScheduler.h"
+
+void FifoIOScheduler::add(const IORequest &request){
+    queue.push_back(request);
+}
+
+IORequest FifoIOScheduler::next([[maybe_unused]] const IIODevice &device, [[maybe_unused]] uint64_t now){
+    IORequest request = queue.front();
+    queue.pop_front();
+    return request;
+}
+
+size_t FifoIOScheduler::size() const{
+    return queue.size();
+}
+
+std::string FifoIOScheduler::getName() const{
+    return "fifo";
+}
+
+void ScanIOScheduler::add(const IORequest &request){
+    byPosition.emplace(request.position, request);
+}
+
+IORequest ScanIOScheduler::next(const IIODevice &device, [[maybe_unused]] uint64_t now){
+    uint32_t head = device.getPosition();
+    auto it = byPosition.end();
+
+    if (ascending){
+        it = byPosition.lower_bound(head);
+        if (it == byPosition.end()){
+            ascending = false;
+            it = std::prev(byPosition.end());
+        }
+    }
+    else{
+        it = byPosition.upper_bound(head);
+        if (it == byPosition.begin()){
+            ascending = true;
+            it = byPosition.begin();
+        }
+        else
+            --it;
+    }
+
+    IORequest request = it->second;
+    byPosition.erase(it);
+    return request;
+}
+
+size_t ScanIOScheduler::size() const{
+    return byPosition.size();
+}
+
+std::string ScanIOScheduler::getName() const{
+    return "scan";
+}
+
+void DeadlineIOScheduler::add(const IORequest &request){
+    bySequence.emplace(request.sequence, request);
+    byPosition.emplace(request.position, request.sequence);
+}
+
+IORequest DeadlineIOScheduler::next(const IIODevice &device, uint64_t now){
+    // Deadlines are a fixed offset from submission, so the oldest request expires first
+    auto oldest = bySequence.begin();
+    uint64_t sequence;
+
+    if (oldest->second.deadline <= now)
+        sequence = oldest->first;
+    else{
+        auto it = byPosition.lower_bound({ device.getPosition(), 0 });
+        if (it == byPosition.end())
+            it = byPosition.begin();
+        sequence = it->second;
+    }
+
+    auto entry = bySequence.find(sequence);
+    IORequest request = entry->second;
+    bySequence.erase(entry);
+    byPosition.erase({ request.position, request.sequence });
+
+    return request;
+}
+
+size_t DeadlineIOScheduler::size() const{
+    return bySequence.size();
+}
+
+std::string DeadlineIOScheduler::getName() const{
+    return "deadline";
+}
@@ -0,0 +1,67 @@
+#pragma once
+#ifndef IO_SCHEDULER_H
+#define IO_SCHEDULER_H
+
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+#include <string>
+
+#include "IODevice.h"
+
+// Orders the requests waiting on one device
+class IIOScheduler{
+public:
+    virtual ~IIOScheduler() = default;
+
+    virtual void add(const IORequest &request) = 0;
+
+    // Removes and returns the request to service next. Only called when not empty.
+    virtual IORequest next(const IIODevice &device, uint64_t now) = 0;
+
+    virtual size_t size() const = 0;
+    virtual std::string getName() const = 0;
+};
+
+// Requests are served in arrival order
+class FifoIOScheduler : public IIOScheduler{
+public:
+    void add(const IORequest &request) override;
+    IORequest next(const IIODevice &device, uint64_t now) override;
+    size_t size() const override;
+    std::string getName() const override;
+
+private:
+    std::deque<IORequest> queue;
+};
+
+// Elevator: the head keeps moving in one direction serving requests on the way and turns
+// around when nothing is left ahead of it
+class ScanIOScheduler : public IIOScheduler{
+public:
+    void add(const IORequest &request) override;
+    IORequest next(const IIODevice &device, uint64_t now) override;
+    size_t size() const override;
+    std::string getName() const override;
+
+private:
+    std::multimap<uint32_t, IORequest> byPosition;
+    bool ascending = true;
+};
+
+// One-way sweep in position order, except that a request past its deadline is served first
+// so nothing starves behind a busy region of the disk
+class DeadlineIOScheduler : public IIOScheduler{
+public:
+    void add(const IORequest &request) override;
+    IORequest next(const IIODevice &device, uint64_t now) override;
+    size_t size() const override;
+    std::string getName() const override;
+
+private:
+    std::map<uint64_t, IORequest> bySequence;
+    std::set<std::pair<uint32_t, uint64_t>> byPosition;
+};
+
+#endif
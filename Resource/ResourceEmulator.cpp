@@ -0,0 +1,230 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "ResourceEmulator.h"
+
+ResourceEmulator* ResourceEmulator::sharedInstance = nullptr;
+
+ResourceEmulator& ResourceEmulator::getInstance(){
+    if (!sharedInstance)
+        initialize();
+
+    return *sharedInstance;
+}
+
+void ResourceEmulator::initialize(){
+    if (!sharedInstance)
+        sharedInstance = new ResourceEmulator();
+}
+
+void ResourceEmulator::destroy(){
+    if (sharedInstance){
+        delete sharedInstance;
+        sharedInstance = nullptr;
+    }
+}
+
+ResourceEmulator::ResourceEmulator() : ioScheduler("fifo"), numDisks(1), numDevices(1), diskTracks(1024),
+    diskSeekTime(5), diskTransferTime(500), deviceLatency(2000), deadline(50000),
+    nextSequence(0), lastAdvance(0), pending(0){
+    createDevices();
+}
+
+ResourceEmulator::~ResourceEmulator() {}
+
+void ResourceEmulator::getInfo(){
+    std::cout << "I/O Configuration Information:" << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+    std::cout << "I/O Scheduler: " << ioScheduler << std::endl;
+    std::cout << "Disks: " << numDisks << std::endl;
+    std::cout << "Fixed Latency Devices: " << numDevices << std::endl;
+    std::cout << "Disk Tracks: " << diskTracks << std::endl;
+    std::cout << "Disk Seek Time Per Track: " << diskSeekTime << " us" << std::endl;
+    std::cout << "Disk Transfer Time: " << diskTransferTime << " us" << std::endl;
+    std::cout << "Device Latency: " << deviceLatency << " us" << std::endl;
+    std::cout << "I/O Deadline: " << deadline / 1000 << " ms" << std::endl;
+}
+
+void ResourceEmulator::readConfigFile(const std::string& filename){
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Error opening config file: " + filename);
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string key, value;
+        if (iss >> key >> value) {
+            if (key == "io-scheduler")
+                ioScheduler = value;
+            else if (key == "io-disks")
+                numDisks = std::max(0, std::stoi(value));
+            else if (key == "io-devices")
+                numDevices = std::max(0, std::stoi(value));
+            else if (key == "disk-tracks")
+                diskTracks = std::stoul(value);
+            else if (key == "disk-seek-us")
+                diskSeekTime = std::stoull(value);
+            else if (key == "disk-transfer-us")
+                diskTransferTime = std::stoull(value);
+            else if (key == "device-latency-us")
+                deviceLatency = std::stoull(value);
+            else if (key == "io-deadline-ms")
+                deadline = std::stoull(value) * 1000;
+        }
+    }
+
+    if (ioScheduler != "fifo" && ioScheduler != "scan" && ioScheduler != "deadline"){
+        std::cerr << "Warning: Unknown io-scheduler '" << ioScheduler << "', using fifo" << std::endl;
+        ioScheduler = "fifo";
+    }
+
+    // Without any device IO still has to complete somewhere
+    if (numDisks + numDevices == 0)
+        numDevices = 1;
+
+    createDevices();
+    file.close();
+}
+
+// Requests still in flight when the devices are rebuilt, e.g. by a second 'initialize', are moved
+// onto the new devices in arrival order, so no blocked process waits on a device that is gone
+void ResourceEmulator::createDevices(){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<std::pair<uint16_t, IORequest>> inFlight;
+    uint32_t oldCount = static_cast<uint32_t>(devices.size());
+    for (uint32_t i = 0; i < oldCount; ++i){
+        Device &device = devices[i];
+        if (device.busy)
+            inFlight.push_back({ static_cast<uint16_t>(device.current.block * oldCount + i), device.current });
+
+        while (device.queue->size() > 0){
+            IORequest request = device.queue->next(*device.device, lastAdvance);
+            inFlight.push_back({ static_cast<uint16_t>(request.block * oldCount + i), request });
+        }
+    }
+    std::sort(inFlight.begin(), inFlight.end(),
+              [](const auto &a, const auto &b){ return a.second.sequence < b.second.sequence; });
+
+    devices.clear();
+    devices.resize(numDisks + numDevices);
+
+    for (int i = 0; i < numDisks + numDevices; ++i){
+        if (i < numDisks)
+            devices[i].device = std::make_unique<DiskDevice>(diskTracks, diskSeekTime, diskTransferTime);
+        else
+            devices[i].device = std::make_unique<FixedLatencyDevice>(deviceLatency);
+
+        devices[i].queue = createScheduler();
+    }
+
+    for (const auto &[operand, request] : inFlight)
+        enqueue(request, operand, lastAdvance);
+}
+
+std::unique_ptr<IIOScheduler> ResourceEmulator::createScheduler() const{
+    if (ioScheduler == "scan")
+        return std::make_unique<ScanIOScheduler>();
+    else if (ioScheduler == "deadline")
+        return std::make_unique<DeadlineIOScheduler>();
+
+    return std::make_unique<FifoIOScheduler>();
+}
+
+void ResourceEmulator::submit(uint32_t process, uint16_t operand, uint64_t now){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    IORequest request;
+    request.process = process;
+    request.submitTime = now;
+    request.deadline = now + deadline;
+    request.sequence = nextSequence++;
+    ++pending;
+
+    enqueue(request, operand, now);
+}
+
+// Routes the request to the device its operand picks and starts it if the device is idle.
+// Called with the mutex held.
+void ResourceEmulator::enqueue(IORequest request, uint16_t operand, uint64_t now){
+    Device &device = devices[operand % devices.size()];
+    request.block = operand / static_cast<uint32_t>(devices.size());
+    request.position = device.device->locate(request.block);
+
+    device.depthTotal += device.queue->size() + (device.busy ? 1 : 0);
+    ++device.submitted;
+
+    device.queue->add(request);
+    if (!device.busy)
+        startNext(device, std::max(now, device.completesAt));
+}
+
+void ResourceEmulator::advance(uint64_t now, std::vector<uint32_t> &completed){
+    std::lock_guard<std::mutex> lock(mutex);
+    lastAdvance = std::max(lastAdvance, now);
+
+    for (Device &device : devices){
+        // Requests queued behind each other run back to back in device time, however coarsely
+        // the scheduler happens to poll
+        while (device.busy && device.completesAt <= now){
+            uint64_t wait = device.completesAt - device.current.submitTime;
+
+            device.busy = false;
+            device.busyTime += device.completesAt - device.startedAt;
+            ++device.completed;
+            device.totalWait += wait;
+            device.maxWait = std::max(device.maxWait, wait);
+            --pending;
+            completed.push_back(device.current.process);
+
+            if (device.queue->size() > 0)
+                startNext(device, device.completesAt);
+        }
+    }
+}
+
+void ResourceEmulator::startNext(Device &device, uint64_t now){
+    device.current = device.queue->next(*device.device, now);
+    device.busy = true;
+
+    // A request submitted after the device went idle, but before the completion was polled, starts on arrival
+    device.startedAt = std::max(now, device.current.submitTime);
+    device.completesAt = device.startedAt + device.device->service(device.current);
+}
+
+size_t ResourceEmulator::getPendingRequests() const{
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
+
+void ResourceEmulator::printStatistics(){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << "|              I/O STATISTICS            |" << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+    std::cout << " I/O Scheduler: " << ioScheduler << std::endl;
+
+    for (size_t i = 0; i < devices.size(); ++i){
+        const Device &device = devices[i];
+        double utilization = lastAdvance ? 100.0 * device.busyTime / lastAdvance : 0.0;
+        double averageDepth = device.submitted ? static_cast<double>(device.depthTotal) / device.submitted : 0.0;
+        double averageWait = device.completed ? device.totalWait / 1000.0 / device.completed : 0.0;
+
+        std::cout << std::endl;
+        std::cout << " " << device.device->getName() << " " << i << std::endl;
+        std::cout << "      Utilization:            " << utilization << " %" << std::endl;
+        std::cout << "      Queue Depth:            " << device.queue->size() + (device.busy ? 1 : 0) << std::endl;
+        std::cout << "      Avg Queue Depth:        " << averageDepth << std::endl;
+        std::cout << "      Completed Requests:     " << device.completed << std::endl;
+        std::cout << "      Avg I/O Wait:           " << averageWait << " ms" << std::endl;
+        std::cout << "      Max I/O Wait:           " << device.maxWait / 1000.0 << " ms" << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "+----------------------------------------+" << std::endl;
+}
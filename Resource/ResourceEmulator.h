@@ -2,11 +2,80 @@
 #ifndef RESOURCE_EMULATOR_H
 #define RESOURCE_EMULATOR_H
 
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "IODevice.h"
+#include "IOScheduler.h"
+
+// Simulated I/O devices. Processes that execute IO are parked here off-core while their request
+// waits in the device queue and is serviced, and are handed back to the scheduler on completion.
+// Time is in microseconds of scheduler time.
 class ResourceEmulator{
 public:
-    ResourceEmulator();
+    static ResourceEmulator& getInstance();
+    static void initialize();
+    static void destroy();
+
+    void getInfo();
+    void readConfigFile(const std::string& filename);
+
+    // The operand of the IO instruction picks the device and the block on it
+    void submit(uint32_t process, uint16_t operand, uint64_t now);
+
+    // Completes every request finished by now and appends the slots of their processes
+    void advance(uint64_t now, std::vector<uint32_t> &completed);
+
+    size_t getPendingRequests() const;
+    void printStatistics();
+
 private:
+    ResourceEmulator();
+    ~ResourceEmulator();
+    ResourceEmulator(const ResourceEmulator&) = delete;
+    ResourceEmulator& operator=(const ResourceEmulator&) = delete;
+
+    struct Device{
+        std::unique_ptr<IIODevice> device;
+        std::unique_ptr<IIOScheduler> queue;
+
+        bool busy = false;
+        IORequest current = {};
+        uint64_t startedAt = 0;
+        uint64_t completesAt = 0;
+
+        uint64_t busyTime = 0;
+        uint64_t completed = 0;
+        uint64_t submitted = 0;
+        uint64_t depthTotal = 0;
+        uint64_t totalWait = 0;
+        uint64_t maxWait = 0;
+    };
+
+    void createDevices();
+    void enqueue(IORequest request, uint16_t operand, uint64_t now);
+    void startNext(Device &device, uint64_t now);
+    std::unique_ptr<IIOScheduler> createScheduler() const;
+
+    std::vector<Device> devices;
+    std::string ioScheduler;
+    int numDisks;
+    int numDevices;
+    uint32_t diskTracks;
+    uint64_t diskSeekTime;
+    uint64_t diskTransferTime;
+    uint64_t deviceLatency;
+    uint64_t deadline;
+
+    uint64_t nextSequence;
+    uint64_t lastAdvance;
+    size_t pending;
 
+    mutable std::mutex mutex;
+    static ResourceEmulator* sharedInstance;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <algorithm>
+
+#include "ScreenBuffer.h"
+#include "UI_Manager.h"
+
+ScreenBuffer::ScreenBuffer() : width(0), height(0), valid(false) {}
+
+void ScreenBuffer::resize(int width, int height){
+    if (width == this->width && height == this->height)
+        return;
+
+    this->width = width;
+    this->height = height;
+    back.assign(static_cast<size_t>(width) * height, Cell());
+    front.assign(back.size(), Cell());
+    valid = false;
+}
+
+int ScreenBuffer::getWidth() const{
+    return width;
+}
+
+int ScreenBuffer::getHeight() const{
+    return height;
+}
+
+void ScreenBuffer::clear(){
+    std::fill(back.begin(), back.end(), Cell());
+}
+
+void ScreenBuffer::put(int x, int y, const std::string &text, int color){
+    if (y < 0 || y >= height)
+        return;
+
+    for (size_t i = 0; i < text.size() && x + static_cast<int>(i) < width; ++i){
+        if (x + static_cast<int>(i) < 0)
+            continue;
+
+        Cell &cell = back[static_cast<size_t>(y) * width + x + i];
+        cell.ch = text[i];
+        cell.color = static_cast<uint8_t>(color);
+    }
+}
+
+void ScreenBuffer::invalidate(){
+    valid = false;
+}
+
+size_t ScreenBuffer::present(){
+    // An unknown screen is redrawn whole; no cell holds a NUL, so every one differs
+    if (!valid){
+        UI_Manager::getInstance().enableVirtualTerminal();
+        std::fill(front.begin(), front.end(), Cell{ '\0', 0 });
+    }
+
+    output.clear();
+    output += "\x1b" "7";
+
+    size_t changed = 0;
+    int cursorX = -1, cursorY = -1, color = 0;
+
+    for (int y = 0; y < height; ++y){
+        for (int x = 0; x < width; ++x){
+            const Cell &cell = back[static_cast<size_t>(y) * width + x];
+            if (!(cell != front[static_cast<size_t>(y) * width + x]))
+                continue;
+
+            if (x != cursorX || y != cursorY)
+                output += "\x1b[" + std::to_string(y + 1) + ";" + std::to_string(x + 1) + "H";
+            if (cell.color != color){
+                output += UI_Manager::colorSequence(cell.color);
+                color = cell.color;
+            }
+
+            output += cell.ch;
+            cursorX = x + 1;
+            cursorY = y;
+            ++changed;
+        }
+    }
+
+    if (color != 0)
+        output += UI_Manager::colorSequence(0);
+    output += "\x1b" "8";
+
+    if (changed > 0){
+        std::cout.write(output.data(), output.size());
+        std::cout.flush();
+    }
+
+    front = back;
+    valid = true;
+    return changed;
+}
+
+std::string ScreenBuffer::toText() const{
+    std::string text;
+
+    for (int y = 0; y < height; ++y){
+        std::string line;
+        for (int x = 0; x < width; ++x)
+            line += back[static_cast<size_t>(y) * width + x].ch;
+
+        line.erase(line.find_last_not_of(' ') + 1);
+        text += line + '\n';
+    }
+
+    return text;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef SCREEN_BUFFER_H
+#define SCREEN_BUFFER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Character grid for full-screen views. A view draws its next frame into the back buffer, and
+// present() compares it with the front buffer, which holds what the terminal shows, and writes
+// only the cells that changed: one write of ANSI cursor moves, colors and text. The cursor is
+// saved and restored around it, so a redraw from another thread leaves the input line alone.
+class ScreenBuffer{
+public:
+    ScreenBuffer();
+
+    // Resizing forgets what the terminal shows
+    void resize(int width, int height);
+    int getWidth() const;
+    int getHeight() const;
+
+    // Blanks the back buffer before a frame is drawn
+    void clear();
+    // Writes text from column x of row y, clipped at the edges. Colors are FOREGROUND_* bits, 0 for the default.
+    void put(int x, int y, const std::string &text, int color = 0);
+    // Makes the next present() redraw every cell, e.g. after the screen was cleared
+    void invalidate();
+    // Writes the changed cells to the terminal and returns how many there were
+    size_t present();
+    // The back buffer as plain lines with trailing spaces trimmed, for headless output
+    std::string toText() const;
+
+private:
+    struct Cell{
+        char ch = ' ';
+        uint8_t color = 0;
+
+        bool operator!=(const Cell &other) const { return ch != other.ch || color != other.color; }
+    };
+
+    int width;
+    int height;
+    std::vector<Cell> front;
+    std::vector<Cell> back;
+    bool valid;
+    // Kept between frames so a present() does not allocate
+    std::string output;
+};
+
+#endif
@@ -2,14 +2,18 @@
 #include <ctime>
 #include <iomanip>
 #include <vector>
-#include <Windows.h>
+#include <cstring>
+#ifndef _WIN32
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
 
 #include "UI_Manager.h"
 
 using namespace std;
 
 UI_Manager* UI_Manager::sharedInstance = nullptr;
-int UI_Manager::pid_generate = -1;
+std::atomic<int> UI_Manager::pid_generate{-1};
 
 UI_Manager& UI_Manager::getInstance(){
     if (!sharedInstance)
@@ -31,10 +35,12 @@ void UI_Manager::destroy(){
 }
 
 void UI_Manager::clear(){
+    if (headless)
+        return;
 #ifdef _WIN32
     system("cls");
 #else
-    system("clear");
+    cout << "\x1b[2J\x1b[3J\x1b[H" << flush;
 #endif
 }
 
@@ -61,8 +67,8 @@ Type 'exit' to quit, 'clear' to clear the screen.
 )";
 }
 
-void UI_Manager::printMainCommandList(){
-    cout <<
+namespace {
+    const char* const MAIN_COMMAND_LIST =
 R"(
 ====================================================================================================
                                     List of all possible commands
@@ -72,20 +78,45 @@ R"(
 'marquee'                       ->      Displays a marquee animation with keyboard polling.
 'screen'                        ->      Displays additional info about the main console.
 'screen -s <name>'              ->      Creates a screen.
+'screen -s <name> -g <group>'   ->      Creates a screen charged to the given memory and CPU group.
+'screen -s <name> --from <p>'   ->      Creates a screen for a fork of process p, sharing its memory.
 'screen -r <name>'              ->      Loads selected screen.
 'screen -d <name>'              ->      Deletes selected screen.
 'screen -ls'                    ->      List all screens.
 'scheduler-test'                ->      Runs the scheduler; outputs sample processes.
 'scheduler-stop'                ->      Stops the scheduler on generating running processes.
 'report-util'                   ->      Logs the 'screen -ls' command in a text file.
-'process-smi'                   ->      View of the memory allocation and utilization of processors
+'process-smi'                   ->      View of the memory allocation and utilization of processors. 'auto <ms>' keeps it live.
 'view-config'                   ->      Views the configuration of the scheduler and memory.
 'vmstat'                        ->      More detailed view on the paging allocator.
+'iostat'                        ->      Utilization, queue depth and wait time of the I/O devices.
+'ipcstat'                       ->      Message throughput and blocking on the SEND/RECV channels.
+'lockstat'                      ->      Contention, hold and wait times of the locks and semaphores.
+'loadstat'                      ->      Fault rate and active processes over time under load control.
+'cpustat'                       ->      CPU ticks, dispatches and throttled time of each CPU group.
+'benchmark <name>'              ->      Runs a performance benchmark. 'benchmark' lists them.
 ====================================================================================================
 
 )";
 }
 
+void UI_Manager::printMainCommandList(){
+    cout << MAIN_COMMAND_LIST;
+}
+
+// One list line per command, so the count cannot drift from the help text
+int UI_Manager::getMainCommandCount(){
+    int count = 0;
+    for (const char* line = MAIN_COMMAND_LIST; line; line = strchr(line, '\n')){
+        if (*line == '\n')
+            ++line;
+        if (*line == '\'')
+            ++count;
+    }
+
+    return count;
+}
+
 void UI_Manager::printMessage(const std::string &message){
     cout << message << endl;
 }
@@ -93,24 +124,50 @@ void UI_Manager::printMessage(const std::string &message){
 std::string UI_Manager::generateTimestamp(){
   auto now = std::chrono::system_clock::now();
   auto now_c = std::chrono::system_clock::to_time_t(now);
+
+  // Timestamps only change once a second, so reuse the last formatted one
+  thread_local std::time_t cachedTime = 0;
+  thread_local std::string cachedTimestamp;
+  if (now_c == cachedTime && !cachedTimestamp.empty())
+    return cachedTimestamp;
+
   std::stringstream ss;
   ss << std::put_time(std::localtime(&now_c), "%m/%d/%Y, %I:%M:%S %p");
-  return ss.str();
+  cachedTime = now_c;
+  cachedTimestamp = ss.str();
+  return cachedTimestamp;
 }
 
+// Headless output has no cursor to move, so columns are only kept apart by a space
 void UI_Manager::setCursorPosition(int x, int y){
+    if (headless){
+        std::cout << ' ';
+        return;
+    }
+#ifdef _WIN32
     COORD coord;
     coord.X = x;
     coord.Y = y;
     SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), coord);
+#else
+    std::cout << "\x1b[" << y + 1 << ";" << x + 1 << "H";
+#endif
 }
 
 void UI_Manager::getConsoleSize(int &width, int &height){
+#ifdef _WIN32
     CONSOLE_SCREEN_BUFFER_INFO csbi;
     if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)){
         width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
         height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
     }
+#else
+    winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0){
+        width = size.ws_col;
+        height = size.ws_row;
+    }
+#endif
     else{
         std::cout << "Error in getting console size" << std::endl;
         return;
@@ -118,12 +175,54 @@ void UI_Manager::getConsoleSize(int &width, int &height){
 }
 
 void UI_Manager::setTextColor(int color, const std::string &text){
+    if (headless){
+        std::cout << text;
+        return;
+    }
+#ifdef _WIN32
     HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
     SetConsoleTextAttribute(hConsole, color);
     std::cout << text;
     SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
+#else
+    std::cout << colorSequence(color) << text << colorSequence(0);
+#endif
+}
+
+void UI_Manager::enableVirtualTerminal(){
+#ifdef _WIN32
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(hConsole, &mode))
+        SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+}
+
+std::string UI_Manager::colorSequence(int color){
+    if (color == 0)
+        return "\x1b[0m";
+
+    // ANSI numbers its colors red = 1, green = 2, blue = 4, the reverse of the Windows bit order
+    int ansi = ((color & FOREGROUND_RED) ? 1 : 0) | ((color & FOREGROUND_GREEN) ? 2 : 0) | ((color & FOREGROUND_BLUE) ? 4 : 0);
+    return "\x1b[" + std::to_string(((color & FOREGROUND_INTENSITY) ? 90 : 30) + ansi) + "m";
+}
+
+void UI_Manager::setRefreshInterval(int milliseconds){
+    refreshInterval = milliseconds > 0 ? milliseconds : 0;
+}
+
+int UI_Manager::getRefreshInterval() const{
+    return refreshInterval;
+}
+
+void UI_Manager::setHeadless(bool headless){
+    this->headless = headless;
+}
+
+bool UI_Manager::isHeadless() const{
+    return headless;
 }
 
 int UI_Manager::generatePID(){
-    return ++pid_generate; 
+    return pid_generate.fetch_add(1) + 1;
 }
\ No newline at end of file
@@ -4,7 +4,21 @@
 
 #include <string>
 #include <iostream>
+#include <atomic>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+// Console text attributes as Windows defines them; the ANSI backend maps them onto SGR colors
+#define FOREGROUND_BLUE 0x0001
+#define FOREGROUND_GREEN 0x0002
+#define FOREGROUND_RED 0x0004
+#define FOREGROUND_INTENSITY 0x0008
+#endif
+
+// Terminal output goes through the Windows console API on Windows and through ANSI escape
+// sequences elsewhere. In headless mode there is no screen clearing, cursor movement or color,
+// so the output of a scripted run can be piped and logged.
 class UI_Manager{
 public:
     static UI_Manager& getInstance();
@@ -15,12 +29,23 @@ public:
     void printMainHeader();
     void printMainWelcome();
     void printMainCommandList();
+    int getMainCommandCount();
     void printMessage(const std::string &message);
     std::string generateTimestamp();
 
     void setCursorPosition(int x, int y);
     void getConsoleSize(int &width, int &height);
     void setTextColor(int color, const std::string &text);
+    void setHeadless(bool headless);
+    bool isHeadless() const;
+    // Lets the Windows console take the ANSI sequences a ScreenBuffer writes; other terminals already do
+    void enableVirtualTerminal();
+    // SGR sequence for FOREGROUND_* bits, 0 resetting to the default color
+    static std::string colorSequence(int color);
+
+    // How often process-smi redraws itself, in milliseconds; 0 waits for 'refresh'
+    void setRefreshInterval(int milliseconds);
+    int getRefreshInterval() const;
 
     static int generatePID();
 
@@ -30,7 +55,10 @@ private:
     UI_Manager& operator=(const UI_Manager&) = delete;
     static UI_Manager* sharedInstance;
     
-    static int pid_generate;
+    // FORK asks for PIDs from the core threads while the console asks from its own
+    static std::atomic<int> pid_generate;
+    bool headless = false;
+    int refreshInterval = 0;
 };
 
 #endif
\ No newline at end of file
@@ -2,23 +2,44 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <fstream>
 
 #include "Console/ConsoleManager.h"
 #include "Processor/Scheduler.h"
 
 
-int main(){
+int main(int argc, char* argv[]){
+    // '--headless [script]' runs the commands in the script, or on stdin, without a terminal
+    bool headless = argc > 1 && std::string(argv[1]) == "--headless";
+    UI_Manager::getInstance().setHeadless(headless);
+
     ConsoleManager::initialize();
     ConsoleManager* consoleManager = ConsoleManager::getInstance();
 
     MainConsole mainConsole;
-    mainConsole.onEnabled();
 
-    while (consoleManager->isRunning()){
-        mainConsole.process();
+    if (headless){
+        if (argc > 2){
+            std::ifstream script(argv[2]);
+            if (!script.is_open()){
+                std::cerr << "Error opening script file: " << argv[2] << std::endl;
+                ConsoleManager::destroy();
+                return 1;
+            }
+            mainConsole.runScript(script);
+        }
+        else
+            mainConsole.runScript(std::cin);
+    }
+    else{
+        mainConsole.onEnabled();
+
+        while (consoleManager->isRunning()){
+            mainConsole.process();
+        }
     }
 
     ConsoleManager::destroy();
-    
+
     return 0;
 }
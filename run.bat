@@ -3,9 +3,21 @@
 rem Compile all .cpp files
 g++ -std=c++20 -Wall -c main.cpp -o main.o
 g++ -std=c++20 -Wall -c UI/UI_Manager.cpp -o UI_Manager.o
+g++ -std=c++20 -Wall -c UI/ScreenBuffer.cpp -o ScreenBuffer.o
 g++ -std=c++20 -Wall -c Processor/CommandProcessor.cpp -o CommandProcessor.o
 g++ -std=c++20 -Wall -c Processor/Process.cpp -o Process.o
 g++ -std=c++20 -Wall -c Processor/Scheduler.cpp -o Scheduler.o
+g++ -std=c++20 -Wall -c Processor/ProcessTable.cpp -o ProcessTable.o
+g++ -std=c++20 -Wall -c Processor/TimerWheel.cpp -o TimerWheel.o
+g++ -std=c++20 -Wall -c Processor/PrintBuffer.cpp -o PrintBuffer.o
+g++ -std=c++20 -Wall -c Processor/PrintWriter.cpp -o PrintWriter.o
+g++ -std=c++20 -Wall -c Processor/FastRandom.cpp -o FastRandom.o
+g++ -std=c++20 -Wall -c Processor/Benchmark.cpp -o Benchmark.o
+g++ -std=c++20 -Wall -c Processor/BatchExecutor.cpp -o BatchExecutor.o
+g++ -std=c++20 -Wall -c Processor/ChannelTable.cpp -o ChannelTable.o
+g++ -std=c++20 -Wall -c Processor/SyncTable.cpp -o SyncTable.o
+g++ -std=c++20 -Wall -c Processor/LoadController.cpp -o LoadController.o
+g++ -std=c++20 -Wall -c Processor/CpuBandwidth.cpp -o CpuBandwidth.o
 g++ -std=c++20 -Wall -c Console/ConsoleManager.cpp -o ConsoleManager.o
 g++ -std=c++20 -Wall -c Console/BaseScreen.cpp -o BaseScreen.o
 g++ -std=c++20 -Wall -c Console/AConsole.cpp -o AConsole.o
@@ -14,22 +26,32 @@ g++ -std=c++20 -Wall -c Console/Consoles/MarqueeConsole.cpp -o MarqueeConsole.o
 g++ -std=c++20 -Wall -c Console/Consoles/ProcessConsole.cpp -o ProcessConsole.o
 g++ -std=c++20 -Wall -c Command/ICommand.cpp -o ICommand.o
 g++ -std=c++20 -Wall -c Command/PrintCommand.cpp -o PrintCommand.o
+g++ -std=c++20 -Wall -c Command/InstructionGenerator.cpp -o InstructionGenerator.o
 g++ -std=c++20 -Wall -c Resource/ResourceEmulator.cpp -o ResourceEmulator.o
+g++ -std=c++20 -Wall -c Resource/IODevice.cpp -o IODevice.o
+g++ -std=c++20 -Wall -c Resource/IOScheduler.cpp -o IOScheduler.o
 g++ -std=c++20 -Wall -c Memory/Memory.cpp -o Memory.o
 g++ -std=c++20 -Wall -c Memory/IMemoryAllocator.cpp -o IMemoryAllocator.o
 g++ -std=c++20 -Wall -c Memory/FlatMemoryAllocator.cpp -o FlatMemoryAllocator.o
 g++ -std=c++20 -Wall -c Memory/PagingMemoryAllocator.cpp -o PagingMemoryAllocator.o
+g++ -std=c++20 -Wall -c Memory/ProcessHeap.cpp -o ProcessHeap.o
+g++ -std=c++20 -Wall -c Memory/AccessPattern.cpp -o AccessPattern.o
+g++ -std=c++20 -Wall -c Memory/TLB.cpp -o TLB.o
+g++ -std=c++20 -Wall -c Memory/PageTable.cpp -o PageTable.o
+g++ -std=c++20 -Wall -c Memory/Cache.cpp -o Cache.o
+g++ -std=c++20 -Wall -c Memory/PageMerger.cpp -o PageMerger.o
 
 
 
 rem Link object files into executable
-g++ main.o UI_Manager.o CommandProcessor.o Process.o Scheduler.o ConsoleManager.o BaseScreen.o AConsole.o MainConsole.o MarqueeConsole.o ProcessConsole.o ICommand.o PrintCommand.o ResourceEmulator.o Memory.o IMemoryAllocator.o FlatMemoryAllocator.o PagingMemoryAllocator.o -o OS_EMULATOR.exe
+g++ main.o UI_Manager.o ScreenBuffer.o CommandProcessor.o Process.o Scheduler.o ProcessTable.o FastRandom.o TimerWheel.o PrintBuffer.o PrintWriter.o Benchmark.o BatchExecutor.o ChannelTable.o SyncTable.o LoadController.o CpuBandwidth.o ConsoleManager.o BaseScreen.o AConsole.o MainConsole.o MarqueeConsole.o ProcessConsole.o ICommand.o PrintCommand.o InstructionGenerator.o ResourceEmulator.o IODevice.o IOScheduler.o Memory.o IMemoryAllocator.o FlatMemoryAllocator.o PagingMemoryAllocator.o ProcessHeap.o AccessPattern.o TLB.o PageTable.o Cache.o PageMerger.o -o OS_EMULATOR.exe
 
 rem Delete all .o files
 del *.o
 
 rem Delete .txt files
 del /q z_memLogs_z\*.txt
+del /q z_printLogs_z\*.txt
 del backingstore.txt
 del backingstore_log.txt
 